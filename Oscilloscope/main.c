@@ -86,20 +86,209 @@
 // The size of the memory buffer used for the DMA and the Maximum Size
 // of the circular buffer used to hold of the data
 #define MEM_BUFFER_SIZE         1024
-#define MaxSize					1024*20 // Must be multiple of MEM_BUFFER_SIZE
+#define MaxSize					(1024*52) // Must be a multiple of 4, two 12-bit values are packed into every 3 bytes
+#define PoolBytes				(MaxSize * 3) // the value and low rings of one channel at MaxSize or of two at half of it
+
+// Both channels of a ring slot packed into 32 bits, channel 1 in the low half and channel 2 in the high half
+#define PAIR_LOW				0x0000FFFF
+#define PairOf(A, B)			((uint32_t)(A) | ((uint32_t)(B) << 16))
+
+// Subtract each half of b from the same half of a, stopping at 0. The Cortex-M4 does this for both halves
+// in one UQSUB16 instruction, other targets use PairSubSatC which gives the same results for halves below 0x8000
+#if defined(__TI_ARM_V7M4__)
+#define PairSubSat(a, b)		((uint32_t)_uqsub16(a, b))
+#elif defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+#define PairSubSat(a, b)		((uint32_t)__uqsub16(a, b))
+#else
+#define PairSubSat(a, b)		PairSubSatC(a, b)
+#endif
 
-// Number of samples to determine the average frequency measured and
-// number of time instances to measure over for the frequency
+// Add both halves of two pairs. As long as no half overflows this is the same as a UADD16 instruction
+#define PairAdd(a, b)			((a) + (b))
+
+// Number of samples to determine the average frequency measured
 #define MeasureAvg				10
-#define TimeAvg					320
+
+// Statistics of every value decoded are kept in blocks of MeasureBlockSlots ring slots for the last MeasureBlocks
+// blocks, so the statistics of a frame are ready once its last slot is stored by putting its blocks together.
+// MeasureBlocks must be a power of 2 and cover more than a frame
+#define MeasureBlockSlots		8
+#define MeasureBlocks			64
+uint32_t MeasureLow = PairOf(4095, 4095), MeasureHigh = 0; // lowest and highest pair of values in the current block
+uint32_t MeasureSum[2]; // sum of the values of each channel in the current block
+uint64_t MeasureSquares[2]; // sum of the squares of the values of each channel in the current block
+uint32_t MeasureAbove[2]; // values of each channel above the hysteresis band since setup, wraps around
+uint32_t MeasureSample = 0, MeasureStart = 0; // values decoded since setup and at the start of the current block
+uint8_t MeasureLevel = 3; // bit for each channel set while it is above its hysteresis band
+uint32_t MeasureUpper = PairOf(4096, 4096), MeasureLower = 0; // pair of top and bottom of the hysteresis bands
+uint32_t MeasureMiddle = PairOf(4096, 4096); // pair of middles of the hysteresis bands
+uint8_t MeasureMid = 0; // bit for each channel set while it is at or above the middle of its band
+uint32_t MeasureCross[2]; // time of the last rising crossing of the middle of each channel, in 1/256 of a value
+uint8_t MeasureBlock = 0, MeasureSlots = 0; // current block and the slots stored in it
+uint32_t BlockLow[MeasureBlocks], BlockHigh[MeasureBlocks], BlockCount[MeasureBlocks]; // lowest and highest pair and number of values of each block
+uint32_t BlockSum[MeasureBlocks][2]; // sums of each block and channel
+uint64_t BlockSquares[MeasureBlocks][2]; // sums of the squares of each block and channel
+uint16_t BlockEdges[MeasureBlocks][2]; // rising edges through the hysteresis band of each block and channel
+uint32_t BlockFirstEdge[MeasureBlocks][2], BlockLastEdge[MeasureBlocks][2]; // crossing time of the first and last edge
+uint32_t BlockFirstAbove[MeasureBlocks][2], BlockLastAbove[MeasureBlocks][2]; // MeasureAbove at the first and last edge
+uint8_t MeasureReady = 0; // set when the statistics of a frame are ready and not yet used by UpdateMeasurements
+uint8_t MeasureOn = 0; // set while a shown measurement needs the statistics of every value, see MeasureNeeded
+uint16_t MeasureMin[2], MeasureMax[2]; // lowest and highest value of each channel over the frame
+float MeasureMean[2], MeasureRms[2]; // mean and RMS of each channel over the frame in mV
+float MeasurePeriod[2], MeasureDuty[2]; // period in seconds and duty cycle in percent, 0 without two rising edges
+
+// Every cycle of both channels, from one rising edge to the next, is kept in a ring of CycleRing cycles with its
+// period, the values it spends above its band and its peak to peak amplitude, for the trend of the last frame.
+// The blocks keep sums of them so the jitter and spreads of a frame are ready with its other statistics. The frozen
+// record of a single sweep is gone through slot by slot instead, and the ring then holds the trend of all of its
+// cycles. Segments of a segmented sweep are not, so their jitter is not found
+#define CycleRing				256
+uint32_t CyclePeriod[2][CycleRing]; // period of each cycle in 1/256 of a value, or of a slot in a frozen record
+uint32_t CycleWidth[2][CycleRing]; // values or slots above the band in each cycle
+uint16_t CycleAmplitude[2][CycleRing]; // peak to peak amplitude of each cycle
+#define CycleValue(t, c, n)		(((t) == 0) ? CyclePeriod[c][n] : ((t) == 1) ? CycleWidth[c][n] : CycleAmplitude[c][n])
+uint32_t CycleCount[2] = {0, 0}, CycleFrameEnd[2]; // cycles since setup and at the end of the last frame
+uint32_t CycleCross[2], CycleAbove[2], CycleLast[2] = {0, 0}; // crossing time and MeasureAbove at the last edge, last period
+uint32_t CycleLow = PairOf(4095, 4095), CycleHigh = 0; // lowest and highest pair of values since the last edge
+uint8_t CycleStarted = 0; // bit for each channel set once an edge started a cycle
+uint16_t BlockCycles[MeasureBlocks][2], BlockSteps[MeasureBlocks][2]; // cycles and cycles after another of each block
+uint64_t BlockPeriods[MeasureBlocks][2], BlockPeriodSquares[MeasureBlocks][2]; // sums of the periods and their squares
+uint64_t BlockStepSquares[MeasureBlocks][2]; // sum of the squared changes in period from one cycle to the next
+uint64_t BlockWidths[MeasureBlocks][2], BlockWidthSquares[MeasureBlocks][2]; // sums of the widths and their squares
+uint64_t BlockAmplitudes[MeasureBlocks][2], BlockAmplitudeSquares[MeasureBlocks][2]; // and of the amplitudes
+uint32_t MeasureCycles[2]; // cycles of each channel in the last frame or frozen record
+float MeasureJitter[2], MeasureCycleJitter[2]; // standard deviation of the period and RMS cycle to cycle jitter in seconds
+float MeasureWidthSpread[2], MeasureAmplitudeSpread[2]; // standard deviation of the width in seconds and amplitude in V
+float CycleSeconds = 0; // seconds of a unit of CyclePeriod
+uint8_t CycleRecord = 0; // set while the cycles are those of the whole frozen record
+int16_t TrendRow[3][CycleRing]; // rows of the last trends of periods, widths and amplitudes drawn
+uint16_t TrendPoints = 0; // points of the last trend drawn
+char TrendDisplay[80]; // string of ASCII characters that display the cycles, the range of periods and the spreads
+
+// Both channels come from the same EPI word, so the time from a rising crossing of channel 1 to the next one of
+// channel 2 is exact to the interpolation. Each is taken within half a period of channel 1 either way and summed
+// in the blocks like the periods
+uint16_t BlockDelays[MeasureBlocks]; // rising edges of channel 2 with a delay in each block
+int64_t BlockDelaySum[MeasureBlocks]; // sum of the delays of channel 2 after channel 1 in 1/256 of a value
+uint32_t MeasureDelays = 0; // delays in the last frame, 0 when the phase and delay were not found
+float MeasureDelay, MeasurePhase; // mean delay of channel 2 after channel 1 in seconds and as a phase in degrees
+
+// Measurements the voltage buttons step through. They are all found in one pass over each displayed frame and kept
+// until the next one. Rise and fall times go from 10% to 90% of the way from the base to the top of the signal,
+// which are the most common levels in its upper and lower halves or its extremes when no level is common
+#define MEAS_VPP				0
+#define MEAS_RMS				1
+#define MEAS_MEAN				2
+#define MEAS_RISE				3
+#define MEAS_FALL				4
+#define MEAS_PWIDTH				5
+#define MEAS_NWIDTH				6
+#define MEAS_DUTY				7
+#define MEAS_OVERSHOOT			8
+#define MEAS_JITTER				9
+#define MEAS_CYCLEJITTER		10
+#define MEAS_PHASE				11 // phase and delay of channel 2 after channel 1, shown for either channel
+#define MEAS_DELAY				12
+#define MeasureKinds			13
+// measurements that are 0 when they are not found in a frame, except phase and delay which can be 0
+#define MeasureMissing(k)		((k) >= MEAS_RISE && (k) != MEAS_OVERSHOOT)
+#define MeasureFound(c, k)		(Measures[c][k] != 0 || !MeasureMissing(k) || ((k) >= MEAS_PHASE && MeasureDelays != 0))
+const char *MeasureNames[MeasureKinds] = {"", "rms", "av", "tr", "tf", "+w", "-w", "dc", "os", "pj", "cc", "ph", "dl"};
+const char *MeasureUnits[MeasureKinds] = {"V", "V", "V", "s", "s", "s", "s", "%", "%", "s", "s", "deg", "s"};
+uint8_t MeasureSelect[2] = {MEAS_VPP, MEAS_VPP}; // measurement shown on the voltage button of each channel
+float Measures[2][MeasureKinds]; // measurements of each channel on the last frame in V, s, % and degrees
+
+// Histogram of every value decoded of channel 1, or of channel 2 when only it is on, in bins of 16 values. It is
+// filled in the decode loop, shown as bars along the right of the waveform each frame or accumulated over frames,
+// and gives the top and base of the channel and the noise around them. The pixels of a displayed frame are binned the
+// same way so FindLevels gives the top and base of both
+#define HistogramBins			256
+#define HistogramSpread			4 // bins on either side of a level that count as noise around it
+#define HistogramWidth			48 // pixels of the longest bar
+#define HistogramFloor			4.62f // spread in values of values spread evenly over one bin, 16 / sqrt(12)
+uint8_t HistogramOn = 0; // 0-off, 1-each frame, 2-accumulated over frames
+uint8_t HistogramShift = 4; // shift of a pair that leaves the bin of the channel in the low 8 bits, 4 or 20
+uint32_t HistogramCounts[HistogramBins]; // values in each bin since the last frame
+uint32_t HistogramShown[HistogramBins], HistogramMost = 0; // values in each bin shown and the count of the fullest bin
+uint8_t HistogramBar[182]; // length of the bar drawn on each row of the waveform
+char HistogramDisplay[64]; // string of ASCII characters that display the top, base and noise from the histogram
+uint32_t SeriesCounts[HistogramBins], SeriesSums[HistogramBins]; // pixels of a frame in each bin and their sum
+// powers of ten that fit in 64 bits and the prefixes of each power of a thousand from nano to giga, for readouts
+const uint64_t PowersOfTen[20] = {1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+		100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+		100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+		1000000000000000000ull, 10000000000000000000ull};
+const char *UnitPrefixes[] = {"n", "u", "m", "", "k", "M", "G"};
+char MeasureDisplay1[12], MeasureDisplay2[12]; // string of ASCII characters that display the chosen measurements
+
+// Running statistics of every measurement and the frequency (MEAS_FREQ) of both channels over the frames since
+// they were last reset, updated with Welford's method so each frame only costs a few operations per measurement
+#define MEAS_FREQ				MeasureKinds
+#define StatKinds				(MeasureKinds + 1)
+uint32_t StatCount[2][StatKinds]; // frames with each measurement found
+float StatMean[2][StatKinds], StatM2[2][StatKinds]; // running mean and sum of squared deviations from it
+float StatMin[2][StatKinds], StatMax[2][StatKinds]; // extremes of each measurement
+float StatLast[2][StatKinds]; // measurement of the last frame it was found on
+uint8_t StatsOn = 0; // set while the statistics of the chosen measurements are shown on the waveform
 
 
 // The destination buffers used for memory transfers.
 static uint32_t *g_ui32DstBuf[MEM_BUFFER_SIZE];
 static uint32_t *g_ui32DstBuf2[MEM_BUFFER_SIZE];
 
-// The 12-bit values from the ADC channels
-uint16_t values[MaxSize], values2[MaxSize];
+// Memory the rings are carved out of by SetupRings depending on which channels are on
+uint8_t RingPool[PoolBytes];
+uint32_t RecordSize = MaxSize / 2; // number of slots in each ring, doubled when only one channel is on
+uint8_t Interleaved = 1; // set when both channels are on and every ring slot holds a value of each
+
+// The 12-bit values from the ADC channels, the highest value of each skipped group in peak detect mode
+// and the whole part of the average of each skipped group in hi-res mode. Read and written with PairGet and PairPut
+uint8_t *values;
+
+// The lowest value of each skipped group in peak detect mode and the fraction (out of 4096)
+// of the average of each skipped group in hi-res mode
+uint8_t *valuesLow;
+
+// Segmented sweep captures MaxSegments frames back to back, each in its own short ring of SegmentSize slots.
+// A segment holds a frame and the slot the trigger can move by, SegmentSize must be even
+#define MaxSegments				64
+#define SegmentSize				324
+uint8_t Segment = 0; // segment being captured, or shown once the sequence is done
+uint32_t SegmentStamp[MaxSegments]; // Timer 1 count at the trigger of each segment
+uint32_t SegmentSlot[MaxSegments]; // ring slot of the trigger of each segment
+uint16_t SegmentFrac[MaxSegments], SegmentPre[MaxSegments]; // trigger fraction and position of each segment
+uint32_t SegmentEnd = 0; // Timer 1 count when the last segment filled
+uint32_t ReArmMin = 0; // fewest Timer 1 counts from a segment filling to the next one being armed
+uint8_t ReArming = 0; // set from a segment filling until the next one is armed
+volatile uint32_t BufferStamp[2]; // Timer 1 count when the primary and alternate DMA buffers were filled
+
+// Reciprocal frequency counter. Timer 3 counts rising edges of a logic level version of channel 1 on PD4 (T3CCP0)
+// and interrupts after every CounterEdges of them, where Timer 1 time stamps the edge. A reading is the whole number
+// of periods between the first and last stamped edge of a gate of at least CounterGateMs, so its resolution is one
+// system clock over the gate at any frequency and no values from the ADC are needed. A gate without an edge for
+// CounterTimeoutMs ends the reading, which covers signals down to 0.2 Hz
+#define CounterGateMs			100
+#define CounterTimeoutMs		5000
+#define CounterBurst			(CounterGateMs * (ui32SysClkFreq / 1000) / 128) // Timer 1 counts between interrupts that take more edges
+#define CounterMaxEdges			0xFFFFFF // edges Timer 3 can count with its prescaler
+#define CounterLatency			16 // system clocks from an edge to the time stamp in the interrupt
+uint8_t CounterOn = 0; // set while the counter replaces the frequency readout of channel 1
+uint32_t CounterEdges = 1; // edges counted by Timer 3 before it interrupts
+volatile uint32_t CounterNext = 1; // edges per interrupt for Timer 3 to take at its next interrupt
+volatile uint32_t CounterStart = 0; // Timer 1 count at the first edge of the gate
+volatile uint32_t CounterCount = 0, CounterDead = 0, CounterWindows = 0; // edges counted, Timer 1 counts not counting and interrupts since the gate started
+volatile uint32_t CounterPeriods = 0, CounterTime = 0, CounterDeadTime = 0, CounterParts = 0; // the same for the last gate and its Timer 1 counts
+volatile uint8_t CounterStarted = 0, CounterReady = 0; // set once the gate has its first edge and when a reading is done
+volatile uint32_t CounterLast = 0, CounterMs = 0; // Timer 1 count and TickMs at the last interrupt
+double CounterFrequency = 0; // last reading in Hz
+char CounterDisplay[24]; // string of ASCII characters that display the last reading
+
+// Minimum and maximum of every group of 1 << SUMMARY_SHIFT values in a frozen record,
+// used to draw zoomed out views of the record without going through every value
+#define SUMMARY_SHIFT			5
+#define SummarySize				(MaxSize >> SUMMARY_SHIFT)
+uint32_t summin[SummarySize], summax[SummarySize];
 
 // The raw inputs from the EPI
 uint32_t inputs[MEM_BUFFER_SIZE], inputs2[MEM_BUFFER_SIZE];
@@ -123,42 +312,77 @@ uint32_t ui32SysClkFreq;
 // pixel length of screen
 #define SERIES_LENGTH 319
 
+// first time scale (100 ms/div) at which auto sweep scrolls the signal across the screen
+#define ROLL_TIME				20
+// milliseconds between scrolls of the roll display. A scroll moves every column, so the display is redrawn and
+// measured once for all values stored in this time instead of for every buffer
+#define RollFrameMs				40
+
 //
 //Intro pictures
 extern const uint8_t g_pui8Image[];
 extern const uint8_t g_pui9Image[];
 
 // global variables
-uint32_t totalsA[SERIES_LENGTH], totalsB[SERIES_LENGTH]; // sum of values when using acquring mode
+uint32_t totalsA[SERIES_LENGTH], totalsB[SERIES_LENGTH]; // running average (times 256) in exponential mode
+uint32_t totals[SERIES_LENGTH]; // sum of the pairs of values when using averaging mode
+uint32_t envlow[SERIES_LENGTH], envhigh[SERIES_LENGTH]; // lowest and highest pair of values of each pixel in envelope mode
 uint16_t totalA, totalB; // calculated value of 12-bit inputs from ADC
-uint16_t l1 = 0, l2 = 0; //variables to keep track of which delta time is measured
+uint32_t Pair; // both inputs from the ADC as a pair
 uint16_t measnum = 0; //variable to keep track of how many frequency measurements have been made
-uint32_t i = 0, j = 0, f = 0, k = 0, m = 0; // various variables to keep track of which index an array is at
+uint32_t i = 0, j = 0, f = 0; // various variables to keep track of which index an array is at
 uint32_t EPIDivide = 5; // The clock frequency divider used to determine how fast the EPI should clock at
-uint16_t freqref1 = 0, freqref2 = 0; // signal value that frequency calculation is based on
-uint16_t t1[TimeAvg], t2[TimeAvg]; // array of delta times to calculate frequency
-uint8_t freqstart2 = 0, freqstop2 = 0, freqstart1 = 0, freqstop1 = 0; // variables to help determine when to start and stopcounting delta time instances
-float t2Avg, t1Avg; // average number of delta time instances
-uint32_t totalt1 = 0, totalt2 = 0; // sum of number of delta time instances
-uint16_t NumAvgt1 = 0, NumAvgt2 = 0; // number of measured delta time instances greater than 0
-uint32_t Frequency1 = 0, Frequency2; // calculated average frequency
+uint64_t Frequency1 = 0, Frequency2; // calculated average frequency in mHz
 uint64_t Frequency1Total = 0, Frequency2Total = 0; // sum of all calculated frequencies
 uint8_t NumFreqs1 = 0, NumFreqs2 = 0; // number of measured frequencies greater than 0
 uint16_t Amp1[4], Amp2[4]; // Amplitude information for signals (0-Min,1-Max,2-Amplitude in pixels,3-Amplitude in mV)
-uint16_t NumAvg = 10; // Number of sets to average when using averaging acquire mode
+uint16_t NumAvg = 10; // Number of sets to average when using averaging acquire mode, at most 16 so the sums fit in a pair
 uint16_t *PTriggerLevel, TriggerLevel = 1000; // Trigger level of signal in pixels and pointer for it
-uint32_t Freq1[MeasureAvg], Freq2[MeasureAvg]; // calcuated frequencies
-uint32_t receive[24]; // array of all bits received from ADC
+uint64_t Freq1[MeasureAvg], Freq2[MeasureAvg]; // calcuated frequencies in mHz
 uint32_t CountSize = 1024; // length of count size for non blocking EPI read assignment
 uint8_t pri, alt; // variables to set when primary or alternate DMA transfers are complete
-uint8_t TriggerStart = 0, Trigger = 0; // to set when to start triggering and to set if a trigger was found within an iteration
-uint8_t GoThrough = 0; // varialbe to set if no trigger is found when going through iteration
-uint8_t CaptureMode = 0, TriggerMode = 0; // variables that determine the acquire (0-normal,1-average) and trigger (0-positive edge,1-negative-edge) modes for the scope
-uint8_t begin = 0; // variable to help determine when the values before the trigger position have already been found
-uint8_t TriggerSource = 1; // determines which signal to trigger off of (1-source 1,2-source 2)
+uint8_t TriggerStart = 0; // to set when to start triggering
+uint8_t TriggerSweep = 0; // sweep mode of the trigger (0-auto,1-normal,2-single,3-segmented)
+uint8_t SingleArmed = 0; // set while a single sweep is waiting for its trigger
+volatile uint32_t TickMs = 0; // milliseconds counted by timer 0 since setup
+uint32_t ArmedMs = 0; // value of TickMs when the trigger was last armed
+uint16_t AutoTimeout = 100; // milliseconds without a trigger before auto mode provides one
+uint8_t RollMode = 0; // set when new values scroll onto the right of the display instead of waiting for a trigger
+uint16_t RollSlots = 0; // number of values stored in the ring since the display last scrolled
+uint32_t RollMs = 0; // value of TickMs when the display last scrolled
+uint8_t RollPaint = 0; // set when the display scrolled and is not yet drawn
+uint8_t CaptureMode = 0, TriggerMode = 0; // variables that determine the acquire (0-normal,1-average,2-exponential average,3-peak detect,4-hi-res,5-envelope) and trigger (0-positive edge,1-negative-edge) modes for the scope
+uint8_t ExpShift = 3; // each new frame is weighted by 1/2^ExpShift in exponential average mode
+uint16_t EnvelopeLimit = 0; // number of frames after which envelope mode starts over (0-never)
+uint32_t RingIndex = 0; // index of the ring slot the next stored value goes to
+uint32_t ValidSlots = 0; // number of values stored in the ring since the time scale was last changed
+uint32_t TriggerSlot = 0; // ring slot of the first value stored at or after the trigger
+uint16_t PostSlots = 0; // number of values stored in the ring since the trigger was found
+uint16_t RecordPre = 0, RecordPost = 0; // number of ring slots kept before the trigger slot and stored after the trigger was found
+uint16_t FramePost = 0; // number of values stored after the trigger was found when the frame can be built
+uint32_t RecordStart = 0; // ring slot of the first value of a frozen record
+uint8_t Frozen = 0; // set once a single sweep has captured its record and DMA is halted
+uint8_t ViewZoom = 0; // ring slots per pixel (as a power of 2) when viewing a frozen record
+uint32_t ViewStart = 0; // record index of the first pixel when viewing a frozen record
+uint8_t DrawBand = 0; // set when each pixel shows the minimum and maximum of several values
+uint16_t WindowPre = 0; // trigger position latched when the trigger was found
+uint16_t SkipCount = 0; // number of values skipped since the last one stored in the ring
+uint32_t BucketLow = PairOf(4095, 4095), BucketHigh = 0; // lowest and highest pair of values since the last one stored in the ring
+uint32_t BucketSumA = 0, BucketSumB = 0; // sum of the values since the last one stored in the ring, used in hi-res mode
+uint16_t PrevA = 2048, PrevB = 2048; // previous values of both channels, used to interpolate the trigger crossing
+uint8_t Armed = 0; // set once enough values are in the ring to fill the display before the trigger position
+uint8_t TriggerSource = 1; // determines which signal to trigger off of (1-source 1,2-source 2,3-pattern 1 AND 2,4-pattern 1 OR 2)
+uint8_t TriggerPattern = 0x0A; // truth table of the trigger pattern indexed by the comparator states (bit 0-channel 1, bit 1-channel 2)
+uint8_t TriggerState = 0; // pattern state of the previous sample, used to find edges of the pattern
+uint16_t QualifierLevel = 2048; // level channel 2 is compared against when a pattern source is used (2048 is 0V)
+char QualifierDisplay[24]; // string of ASCII characters that display the qualifier level in volts
+uint16_t TriggerFrac = 256; // fraction (out of 256) of a ring slot after the slot before TriggerSlot at which the signal crossed the trigger level
 uint16_t NumSkip = 2; // sets the number of values to skip over in order to achieve correct time scale
-uint16_t TriggerPosition = 0; // pixel number to start drawing after trigger is found
+uint16_t TriggerPosition = 0; // pixel number the trigger is drawn at (0 to SERIES_LENGTH), pixels before it are taken from the ring
 uint16_t old1[SERIES_LENGTH], old2[SERIES_LENGTH], pixels[SERIES_LENGTH], pixels2[SERIES_LENGTH]; // pixel heights of both current and last signal
+uint16_t pixelsLow[SERIES_LENGTH], pixelsLow2[SERIES_LENGTH]; // lowest values of each pixel when a band is drawn
+uint32_t finepixels[SERIES_LENGTH], finepixels2[SERIES_LENGTH]; // values of each pixel times 65536 in hi-res mode
+uint16_t bandlow1[SERIES_LENGTH], bandhigh1[SERIES_LENGTH], bandlow2[SERIES_LENGTH], bandhigh2[SERIES_LENGTH]; // screen rows of the last drawn bands
 uint16_t midlevel1, midlevel2; // 0V level for both channels 1 and 2 in pixels calibrated to pixel_divider
 uint16_t *plevel1, *plevel2, level1 = 80, level2 = 160; // 0V level for both channels 1 and 2 in pixels
 uint16_t desiredlevel1 = 80, desiredlevel2 = 160; // Desired 0V level for both channels 1 and 2 in pixels
@@ -174,8 +398,14 @@ uint8_t transfer_done[2] = {0,0}; // keeps track of when the primary or alternat
 uint8_t stopped = 0; // keeps track of whether the signal was stopped from updating
 float pixel_divider1 = 5.461, pixel_divider2 = 5.461; // values describing how much the 12-bit ADC input should be divided by to obtain correct vertical scale divisions
 float mvpixel[14], secpixel[29]; // array of mV/pixel and seconds/pixel for every scale division
-char MagDisplay1[7], MagDisplay2[7]; // string of ASCII characters that display the peak-to-peak voltage of both signals
-char FreqDisplay1[9], FreqDisplay2[9]; // string of ASCII characters that display the frequencies of both signals
+char MagDisplay1[10], MagDisplay2[10]; // string of ASCII characters that display the peak-to-peak voltage of both signals
+char FreqDisplay1[12], FreqDisplay2[12]; // string of ASCII characters that display the frequencies of both signals
+char ZoomDisplay[10]; // string of ASCII characters that display the zoom of a frozen record
+char SegmentDisplay[40]; // string of ASCII characters that display the segment shown, its time and the re-arm time
+char DepthDisplay[10]; // string of ASCII characters that display the number of slots in each ring
+uint8_t CursorsOn = 0; // set while the cursors are drawn on the waveform
+int16_t CursorColumn[2] = {100, 220}, CursorRow[2] = {74, 164}; // columns of the time cursors and rows of the voltage cursors
+char CursorDisplay[48]; // string of ASCII characters that display the time, frequency and voltage between the cursors
 
 //Define Widgets
 tContext sContext;
@@ -187,17 +417,21 @@ extern tCanvasWidget g_sBottom;
 extern tCanvasWidget g_sAddMinusC1;
 extern tCanvasWidget g_sAddMinusC2;
 extern tCanvasWidget g_sAddMinusTime;
+extern tCanvasWidget g_sRecordDepth;
 extern tPushButtonWidget g_sPushBtnAddC1;
 extern tPushButtonWidget g_sPushBtnMinusC1;
 extern tPushButtonWidget g_sPushBtnAddC2;
 extern tPushButtonWidget g_sPushBtnMinusC2;
 extern tPushButtonWidget g_sPushBtnAddTime;
 extern tPushButtonWidget g_sPushBtnMinusTime;
+extern tPushButtonWidget g_sPushBtnHistogram;
+extern tPushButtonWidget g_sPushBtnStatReset;
 extern tContainerWidget g_sContainerAcquire;
 extern tContainerWidget g_sContainerChannels;
 extern tContainerWidget g_sContainerTriggers;
 extern tContainerWidget g_sContainerTriggerSource;
 extern tContainerWidget g_sContainerTriggerMode;
+extern tContainerWidget g_sContainerTriggerSweep;
 extern tContainerWidget g_sContainerFreMagnitudeC1;
 extern tContainerWidget g_sContainerFreMagnitudeC2;
 extern tContainerWidget g_sContainerVolMagnitudeC1;
@@ -207,6 +441,11 @@ extern tSliderWidget g_sTriggerSliderVertical;
 extern tSliderWidget g_sTriggerSliderHorizontal;
 extern tSliderWidget g_sC1Slider;
 extern tSliderWidget g_sC2Slider;
+extern tSliderWidget g_sCursorSliderTime1;
+extern tSliderWidget g_sCursorSliderTime2;
+extern tSliderWidget g_sCursorSliderLevel1;
+extern tSliderWidget g_sCursorSliderLevel2;
+extern tSliderWidget g_sQualifierSlider;
 
 //Used for grid
 int x;
@@ -214,12 +453,9 @@ int y;
 ///////////////
 
 //Used for scale display//////
-char *tempMagVolDivC2;
-char magVolDivC2[] = { 32, 50, 48, 109, 86, 47, 100, 105, 118, 0 };
-char *tempMagVolDivC1;
-char magVolDivC1[] = { 32, 50, 48, 109, 86, 47, 100, 105, 118, 0 };
-char *tempTimVolDivC1;
-char timVolDivC1[] = { 32, 32, 50, 117, 115, 47, 100, 105, 118, 0 };
+char magVolDivC2[10] = "20mV/div";
+char magVolDivC1[10] = "20mV/div";
+char timVolDivC1[10] = "2us/div";
 //////////////////////////////
 void ClrScreen(void);
 void DRadioAcquire(tWidget *pWidgetR);
@@ -246,21 +482,88 @@ void OnSliderChangeVertical(tWidget *psWidget, int32_t i32Value);
 void OnSliderChangeHorizontal(tWidget *psWidget, int32_t i32Value);
 void OnSliderChangeC1(tWidget *psWidget, int32_t i32Value);
 void OnSliderChangeC2(tWidget *psWidget, int32_t i32Value);
+void OnSliderChangeCursor(tWidget *psWidget, int32_t i32Value);
+void OnSliderChangeQualifier(tWidget *psWidget, int32_t i32Value);
+void DrawQualifier(void);
+void DrawCursors(void);
+void HideCursors(void);
+void RestoreColumn(int16_t Column);
+void RestoreRow(int16_t Row);
 void RunStop(tWidget *psWidget);
 void UpdateMeasurements(void);
+void MeasureSeries(uint8_t c, uint16_t *series, uint16_t *low);
+void FormatMeasure(char *Text, uint8_t c);
+void FormatValue(char *Text, float Value, uint8_t Kind);
+void StatAdd(uint8_t c, uint8_t k, float Value);
+void StatReset(void);
+void DrawStats(void);
+void HistogramFrame(void);
+void FindLevels(const uint32_t *Counts, const uint32_t *Sums, uint16_t Low, uint16_t High, float *Level);
+void DrawHistogram(void);
+void HistogramSelect(tWidget *psWidget);
+void StatRestart(tWidget *psWidget);
+void PixelFrequency(void);
+void MeasureEdge(uint8_t Rising);
+void DrawTrend(void);
+void MeasureCrossing(uint8_t Rising);
+float PixelPeriod(uint16_t *series, uint16_t Low, uint16_t High);
+void StoreBlock(void);
+void CloseBlock(void);
+void MeasureFrame(uint16_t Slots);
+void MeasureReset(void);
+uint8_t MeasureNeeded(void);
+double Spread(double Sum, double Squares, uint32_t Count);
+void RecordCycles(void);
 void CalibrateOffset(void);
 void OffSet(tWidget *psWidget);
 void AcquireSelectRadioBtns(tWidget *psWidget, uint32_t bSelected);
 void MathSelectRadioBtns(tWidget *psWidget, uint32_t bSelected);
 void TriggerModeSelect(tWidget *psWidget, uint32_t bSelected);
 void TriggerSourceSelect(tWidget *psWidget, uint32_t bSelected);
+void TriggerSweepSelect(tWidget *psWidget, uint32_t bSelected);
 tPushButtonWidget g_psTopButtons[];
 tPushButtonWidget g_psBotButtons[];
 void setup(void);
 void SetupVoltageDivision(uint8_t Scale, uint8_t Channel);
 void SetupTimeDivision(uint8_t Scale);
 void SetupTrigger(uint16_t Level, uint8_t Start_Position, uint8_t Mode, uint8_t Source);
+void SetupDMA(void);
 void PixelsCalculation(uint32_t input[MEM_BUFFER_SIZE]);
+uint16_t TriggerFraction(uint16_t PrevA, uint16_t A, uint16_t PrevB, uint16_t B, uint16_t Level2);
+uint8_t CaptureWindow(void);
+void ArmTrigger(void);
+void ForceTrigger(void);
+void RollDisplay(void);
+void SetRecordLength(void);
+void FreezeRecord(void);
+void ResumeAcquisition(void);
+void RenderRecord(void);
+void ZoomRecord(int8_t Direction);
+int16_t PixelRow(uint16_t Value, uint16_t Mid, float Divider);
+void Timer0IntHandler(void);
+void Timer3IntHandler(void);
+void CounterSetup(void);
+void CounterUpdate(void);
+void DrawCounter(void);
+uint32_t InterpolatePair(uint8_t *ring, uint32_t n, uint16_t frac);
+void InterpolateFine(uint8_t *ring, uint8_t *fraction, uint32_t n, uint16_t frac, uint32_t *Fine1, uint32_t *Fine2);
+uint16_t RingGet(uint8_t *ring, uint32_t n);
+void RingPut(uint8_t *ring, uint32_t n, uint16_t Value);
+static inline uint32_t PairGet(uint8_t *ring, uint32_t n);
+void PairPut(uint8_t *ring, uint32_t n, uint32_t Value);
+uint32_t PairSubSatC(uint32_t a, uint32_t b);
+uint32_t PairMin(uint32_t a, uint32_t b);
+uint32_t PairMax(uint32_t a, uint32_t b);
+uint8_t PairAtLeast(uint32_t a, uint32_t b);
+void SetupRings(void);
+void SelectSegment(uint8_t k);
+void NextSegment(uint32_t Stamp);
+void ShowSegment(uint8_t k);
+uint32_t SampleStamp(uint32_t *input, uint16_t f);
+void FormatCycles(char *Text, uint32_t Cycles);
+void FormatUnits(char *Text, uint64_t Value, int8_t Exponent, uint8_t Digits, const char *Unit);
+void ShowMagDiv(uint8_t Channel);
+void ShowTimeDiv(void);
 
 
 
@@ -388,6 +691,10 @@ Slider(g_sTriggerSliderVertical,0, 0, 0, &g_sKentec320x240x16_SSD2119, 0, 29, 20
                 ( SL_STYLE_BACKG_FILL|SL_STYLE_FILL|SL_STYLE_OUTLINE | SL_STYLE_VERTICAL),
                 ClrWhite, ClrBlack, ClrSilver, ClrWhite, ClrWhite,
                 &g_sFontCm20, 0, 0, 0, OnSliderChangeVertical);
+Slider(g_sQualifierSlider,0, 0, 0, &g_sKentec320x240x16_SSD2119, 298, 29, 20, 183, 29, 211, 80,
+                ( SL_STYLE_BACKG_FILL|SL_STYLE_FILL|SL_STYLE_OUTLINE | SL_STYLE_VERTICAL),
+                ClrYellow, ClrBlack, ClrSilver, ClrWhite, ClrWhite,
+                &g_sFontCm20, 0, 0, 0, OnSliderChangeQualifier);
 Slider(g_sTriggerSliderHorizontal,0, 0, 0, &g_sKentec320x240x16_SSD2119, 0, 192, 320, 20, 0,320, 160,
                 ( SL_STYLE_BACKG_FILL|SL_STYLE_FILL|SL_STYLE_OUTLINE),
                 ClrWhite, ClrBlack, ClrSilver, ClrWhite, ClrWhite,
@@ -403,6 +710,24 @@ Slider(g_sC2Slider,0, 0, 0, &g_sKentec320x240x16_SSD2119, 298, 29, 20, 183, 29,
                 ClrYellow, ClrBlack, ClrSilver, ClrWhite, ClrWhite,
                 &g_sFontCm20, 0, 0, 0, OnSliderChangeC2);
 
+////Sliders for the cursors, time cursors along the bottom and voltage cursors on both sides////////////////////////
+Slider(g_sCursorSliderTime1,0, 0, 0, &g_sKentec320x240x16_SSD2119, 21, 172, 276, 20, 7, 316, 100,
+                ( SL_STYLE_BACKG_FILL|SL_STYLE_FILL|SL_STYLE_OUTLINE),
+                ClrCyan, ClrBlack, ClrSilver, ClrWhite, ClrWhite,
+                &g_sFontCm20, 0, 0, 0, OnSliderChangeCursor);
+Slider(g_sCursorSliderTime2,0, 0, 0, &g_sKentec320x240x16_SSD2119, 21, 192, 276, 20, 7, 316, 220,
+                ( SL_STYLE_BACKG_FILL|SL_STYLE_FILL|SL_STYLE_OUTLINE),
+                ClrCyan, ClrBlack, ClrSilver, ClrWhite, ClrWhite,
+                &g_sFontCm20, 0, 0, 0, OnSliderChangeCursor);
+Slider(g_sCursorSliderLevel1,0, 0, 0, &g_sKentec320x240x16_SSD2119, 0, 29, 20, 143, 30, 211, 166,
+                ( SL_STYLE_BACKG_FILL|SL_STYLE_FILL|SL_STYLE_OUTLINE | SL_STYLE_VERTICAL),
+                ClrCyan, ClrBlack, ClrSilver, ClrWhite, ClrWhite,
+                &g_sFontCm20, 0, 0, 0, OnSliderChangeCursor);
+Slider(g_sCursorSliderLevel2,0, 0, 0, &g_sKentec320x240x16_SSD2119, 298, 29, 20, 143, 30, 211, 76,
+                ( SL_STYLE_BACKG_FILL|SL_STYLE_FILL|SL_STYLE_OUTLINE | SL_STYLE_VERTICAL),
+                ClrCyan, ClrBlack, ClrSilver, ClrWhite, ClrWhite,
+                &g_sFontCm20, 0, 0, 0, OnSliderChangeCursor);
+
 
 ///////////////////////////////////////////////////////////////////////////
 ///Bottom Buttons//////////////////////////////////////////////////////////
@@ -429,14 +754,14 @@ tPushButtonWidget g_psBotButtons[] =
 										52, 28,
 										(PB_STYLE_OUTLINE | PB_STYLE_TEXT_OPAQUE | PB_STYLE_TEXT | PB_STYLE_FILL),
 										ClrGray, ClrWhite, ClrWhite, ClrRed,
-										g_psFontCm14, "V", 0, 0, 0, 0, DRadioVolMagnitudeC1),
+										g_psFontCm12, "V", 0, 0, 0, 0, DRadioVolMagnitudeC1),
 								RectangularButtonStruct(&g_sBottom,
 										g_psBotButtons + 4, 0,
 										&g_sKentec320x240x16_SSD2119, 159, 212,
 										52, 28,
 										(PB_STYLE_OUTLINE | PB_STYLE_TEXT_OPAQUE | PB_STYLE_TEXT | PB_STYLE_FILL),
 										ClrGray, ClrWhite, ClrWhite, ClrYellow,
-										g_psFontCm14, "V", 0, 0, 0, 0, DRadioVolMagnitudeC2),
+										g_psFontCm12, "V", 0, 0, 0, 0, DRadioVolMagnitudeC2),
 								RectangularButtonStruct(&g_sBottom,
 										g_psBotButtons + 5, 0,
 										&g_sKentec320x240x16_SSD2119, 212, 212,
@@ -465,9 +790,15 @@ RadioButtonStruct(&g_sContainerTriggers, g_psRadioBtnTriggers + 2, 0,
 RadioButtonStruct(&g_sContainerTriggers, g_psRadioBtnTriggers + 3, 0,
 		&g_sKentec320x240x16_SSD2119, 159, 72, 48, 20, RB_STYLE_TEXT,
 		10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss12, "Position", 0, TriggerSelectRadioBtns),
-RadioButtonStruct(&g_sContainerTriggers, 0, 0,
+RadioButtonStruct(&g_sContainerTriggers, g_psRadioBtnTriggers + 4, 0,
 				&g_sKentec320x240x16_SSD2119, 159, 93, 48, 20, RB_STYLE_TEXT,
-				10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss14, "Mode", 0, TriggerSelectRadioBtns)};
+				10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss14, "Mode", 0, TriggerSelectRadioBtns),
+RadioButtonStruct(&g_sContainerTriggers, g_psRadioBtnTriggers + 5, 0,
+				&g_sKentec320x240x16_SSD2119, 159, 114, 48, 20, RB_STYLE_TEXT,
+				10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss14, "Sweep", 0, TriggerSelectRadioBtns),
+RadioButtonStruct(&g_sContainerTriggers, 0, 0,
+				&g_sKentec320x240x16_SSD2119, 159, 135, 48, 20, RB_STYLE_TEXT,
+				10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss14, "Cursor", 0, TriggerSelectRadioBtns)};
 #define NUM_RADIO_BUTTONS_Triggers      (sizeof(g_psRadioBtnTriggers) /   \
                                  sizeof(g_psRadioBtnTriggers[0]))
 
@@ -476,14 +807,22 @@ RadioButtonStruct(&g_sContainerTriggerSource, g_psRadioBtnSource + 1, 0,
 		&g_sKentec320x240x16_SSD2119, 212, 30, 48, 20, RB_STYLE_TEXT,
 		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss14, "  1", 0,
 		TriggerSourceSelect),
-RadioButtonStruct(&g_sContainerTriggerSource, 0, 0,
+RadioButtonStruct(&g_sContainerTriggerSource, g_psRadioBtnSource + 2, 0,
 		&g_sKentec320x240x16_SSD2119, 212, 51, 48, 20, RB_STYLE_TEXT,
 		10, ClrBlack, ClrWhite, ClrYellow, g_psFontCmss14, "  2", 0,
+		TriggerSourceSelect),
+RadioButtonStruct(&g_sContainerTriggerSource, g_psRadioBtnSource + 3, 0,
+		&g_sKentec320x240x16_SSD2119, 212, 72, 48, 20, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss14, "1 & 2", 0,
+		TriggerSourceSelect),
+RadioButtonStruct(&g_sContainerTriggerSource, 0, 0,
+		&g_sKentec320x240x16_SSD2119, 212, 93, 48, 20, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss14, "1 | 2", 0,
 		TriggerSourceSelect)};
 #define NUM_RADIO_BUTTONS_Sources      (sizeof(g_psRadioBtnSource) /   \
                                  sizeof(g_psRadioBtnSource[0]))
 Container(g_sContainerTriggerSource, 0, 0, g_psRadioBtnSource,
-		&g_sKentec320x240x16_SSD2119, 212, 28, 52, 45,
+		&g_sKentec320x240x16_SSD2119, 212, 28, 52, 87,
 		(CTR_STYLE_OUTLINE |CTR_STYLE_FILL ), ClrBlack, ClrWhite, ClrRed,
 		g_psFontCm14, 0);
 
@@ -503,6 +842,31 @@ Container(g_sContainerTriggerMode, 0, 0, g_psRadioBtnTriggerMode,
 		&g_sKentec320x240x16_SSD2119, 212, 80, 52, 45,
 		(CTR_STYLE_OUTLINE |CTR_STYLE_FILL ), ClrBlack, ClrWhite, ClrRed,
 		g_psFontCm14, 0);
+
+tRadioButtonWidget g_psRadioBtnTriggerSweep[] = {
+RadioButtonStruct(&g_sContainerTriggerSweep, g_psRadioBtnTriggerSweep + 1, 0,
+		&g_sKentec320x240x16_SSD2119, 212, 102, 48, 20, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss14, "Auto", 0,
+		TriggerSweepSelect),
+RadioButtonStruct(&g_sContainerTriggerSweep, g_psRadioBtnTriggerSweep + 2, 0,
+		&g_sKentec320x240x16_SSD2119, 212, 123, 48, 20, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss12, "Normal", 0,
+		TriggerSweepSelect),
+RadioButtonStruct(&g_sContainerTriggerSweep, g_psRadioBtnTriggerSweep + 3, 0,
+		&g_sKentec320x240x16_SSD2119, 212, 144, 48, 20, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss14, "Single", 0,
+		TriggerSweepSelect),
+RadioButtonStruct(&g_sContainerTriggerSweep, 0, 0,
+		&g_sKentec320x240x16_SSD2119, 212, 165, 48, 20, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrWhite, g_psFontCmss12, "Segment", 0,
+		TriggerSweepSelect)};
+#define NUM_RADIO_BUTTONS_TriggerSweep     (sizeof(g_psRadioBtnTriggerSweep) /   \
+                                 sizeof(g_psRadioBtnTriggerSweep[0]))
+
+Container(g_sContainerTriggerSweep, 0, 0, g_psRadioBtnTriggerSweep,
+		&g_sKentec320x240x16_SSD2119, 212, 101, 52, 86,
+		(CTR_STYLE_OUTLINE |CTR_STYLE_FILL ), ClrBlack, ClrWhite, ClrRed,
+		g_psFontCm14, 0);
 ///////////////////////////////////////////////////////////////
 
 tRadioButtonWidget g_psRadioBtnChannels[] = {
@@ -514,20 +878,62 @@ RadioButtonStruct(&g_sContainerChannels, g_psRadioBtnChannels + 2, 0,
 		&g_sKentec320x240x16_SSD2119, 212, 51, 48, 20, RB_STYLE_TEXT,
 		10, ClrBlack, ClrWhite, ClrYellow, g_psFontCmss14, "  2", 0,
 		ChannelSelectRadioBtns),
-RadioButtonStruct(&g_sContainerChannels, 0, 0,
+RadioButtonStruct(&g_sContainerChannels, &g_sRecordDepth, 0,
 		&g_sKentec320x240x16_SSD2119, 212, 71, 48, 20, RB_STYLE_TEXT,
 		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss14, "1 & 2", 0, ChannelSelectRadioBtns)};
+
+Canvas(g_sRecordDepth, &g_sContainerChannels, &g_sPushBtnHistogram, 0, &g_sKentec320x240x16_SSD2119, 213,
+		92, 50, 14, CANVAS_STYLE_FILL|CANVAS_STYLE_TEXT, ClrBlack, 0, ClrWhite,
+		g_psFontCmss12, DepthDisplay, 0, 0);
+RectangularButton(g_sPushBtnHistogram, &g_sContainerChannels, &g_sPushBtnStatReset, 0,
+		&g_sKentec320x240x16_SSD2119, 213, 108, 50, 18,
+		(PB_STYLE_OUTLINE | PB_STYLE_TEXT_OPAQUE | PB_STYLE_TEXT | PB_STYLE_FILL),
+		ClrGray, ClrWhite, ClrWhite, ClrWhite, g_psFontCmss12, "Hist off", 0, 0, 0, 0,
+		HistogramSelect);
+RectangularButton(g_sPushBtnStatReset, &g_sContainerChannels, 0, 0,
+		&g_sKentec320x240x16_SSD2119, 213, 127, 50, 18,
+		(PB_STYLE_OUTLINE | PB_STYLE_TEXT_OPAQUE | PB_STYLE_TEXT | PB_STYLE_FILL),
+		ClrGray, ClrWhite, ClrWhite, ClrWhite, g_psFontCmss12, "Stat reset", 0, 0, 0, 0,
+		StatRestart);
 #define NUM_RADIO_BUTTONS_Channels      (sizeof(g_psRadioBtnChannels) /   \
                                  sizeof(g_psRadioBtnChannels[0]))
 
 tRadioButtonWidget g_psRadioBtnAcquire[] = {
 RadioButtonStruct(&g_sContainerAcquire, g_psRadioBtnAcquire + 1, 0,
-		&g_sKentec320x240x16_SSD2119, 266, 40, 48, 20, RB_STYLE_TEXT,
+		&g_sKentec320x240x16_SSD2119, 266, 31, 48, 18, RB_STYLE_TEXT,
 		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss12, "Normal", 0,
 		AcquireSelectRadioBtns),
-RadioButtonStruct(&g_sContainerAcquire,  0, 0,
-		&g_sKentec320x240x16_SSD2119, 266, 61, 48, 20, RB_STYLE_TEXT,
+RadioButtonStruct(&g_sContainerAcquire, g_psRadioBtnAcquire + 2, 0,
+		&g_sKentec320x240x16_SSD2119, 266, 50, 48, 18, RB_STYLE_TEXT,
 		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss12, "Average", 0,
+		AcquireSelectRadioBtns),
+RadioButtonStruct(&g_sContainerAcquire, g_psRadioBtnAcquire + 3, 0,
+		&g_sKentec320x240x16_SSD2119, 266, 69, 48, 18, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss12, "Exp 4", 0,
+		AcquireSelectRadioBtns),
+RadioButtonStruct(&g_sContainerAcquire, g_psRadioBtnAcquire + 4, 0,
+		&g_sKentec320x240x16_SSD2119, 266, 88, 48, 18, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss12, "Exp 8", 0,
+		AcquireSelectRadioBtns),
+RadioButtonStruct(&g_sContainerAcquire, g_psRadioBtnAcquire + 5, 0,
+		&g_sKentec320x240x16_SSD2119, 266, 107, 48, 18, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss12, "Exp 16", 0,
+		AcquireSelectRadioBtns),
+RadioButtonStruct(&g_sContainerAcquire, g_psRadioBtnAcquire + 6, 0,
+		&g_sKentec320x240x16_SSD2119, 266, 126, 48, 18, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss12, "Peak", 0,
+		AcquireSelectRadioBtns),
+RadioButtonStruct(&g_sContainerAcquire, g_psRadioBtnAcquire + 7, 0,
+		&g_sKentec320x240x16_SSD2119, 266, 145, 48, 18, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss12, "Hi-Res", 0,
+		AcquireSelectRadioBtns),
+RadioButtonStruct(&g_sContainerAcquire, g_psRadioBtnAcquire + 8, 0,
+		&g_sKentec320x240x16_SSD2119, 266, 164, 48, 18, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss12, "Env", 0,
+		AcquireSelectRadioBtns),
+RadioButtonStruct(&g_sContainerAcquire,  0, 0,
+		&g_sKentec320x240x16_SSD2119, 266, 183, 48, 18, RB_STYLE_TEXT,
+		10, ClrBlack, ClrWhite, ClrRed, g_psFontCmss12, "Env 100", 0,
 		AcquireSelectRadioBtns)};
 #define NUM_RADIO_BUTTONS_Acquire      (sizeof(g_psRadioBtnAcquire) /   \
                                  sizeof(g_psRadioBtnAcquire[0]))
@@ -598,18 +1004,18 @@ Container(g_sContainerMath, 0, 0, g_psRadioBtnMath,
 		g_psFontCm14, 0);
 
 Container(g_sContainerTriggers, 0, 0, g_psRadioBtnTriggers,
-		&g_sKentec320x240x16_SSD2119, 159, 28, 52, 85,
+		&g_sKentec320x240x16_SSD2119, 159, 28, 52, 127,
 		(CTR_STYLE_OUTLINE |CTR_STYLE_FILL ), ClrBlack, ClrWhite, ClrRed,
 		g_psFontCm14, 0);
 
 
 Container(g_sContainerChannels, 0, 0, g_psRadioBtnChannels,
-		&g_sKentec320x240x16_SSD2119, 212, 28, 52, 75,
+		&g_sKentec320x240x16_SSD2119, 212, 28, 52, 119,
 		(CTR_STYLE_OUTLINE |CTR_STYLE_FILL ), ClrBlack, ClrWhite, ClrRed,
 		g_psFontCm14, 0);
 
 Container(g_sContainerAcquire, 0, 0, g_psRadioBtnAcquire,
-		&g_sKentec320x240x16_SSD2119, 265, 28, 52, 60,
+		&g_sKentec320x240x16_SSD2119, 265, 28, 52, 175,
 		(CTR_STYLE_OUTLINE |CTR_STYLE_FILL ), ClrBlack, ClrWhite, ClrRed,
 		g_psFontCm14, 0);
 Container(g_sContainerFreMagnitudeC1, 0, 0, g_psRadioBtnFreqMagC1,
@@ -647,39 +1053,320 @@ void AddMagDivC1(tWidget *psWidget) {
 	midlevel1 = 2048/pixel_divider1 + level1;
 	midlevel2 = 2048/pixel_divider2 + level2;
 
-	//make it 25V
-	if (magVolDivC1[1] == 50 && magVolDivC1[2] == 48 && magVolDivC1[3] == 32)
-		magVolDivC1[2] = 53;
-	//stay at 25V
-	else if (magVolDivC1[1] == 50 && magVolDivC1[2] == 53
-			&& magVolDivC1[3] == 32)
-		magVolDivC1[2] = 53;
-	// mV to V at 1 V
-	else if (magVolDivC1[0] == 53) {
-		tempMagVolDivC1 = magVolDivC1 + 2;
-		*tempMagVolDivC1 = 49;
-		magVolDivC1[0] = 32;
-		magVolDivC1[1] = 32;
-		magVolDivC1[3] = 32;
-	}
-	//every time from 5 to 10
-	else if (*tempMagVolDivC1 == 53) {
-		*tempMagVolDivC1 = 48;
-		tempMagVolDivC1--;
-		*tempMagVolDivC1 = 49;
-	}
-	//every time from 1 to 2
-	else if (*tempMagVolDivC1 == 49)
-		*tempMagVolDivC1 = 50;
-	//every time from 2 to 5
-	else if (*tempMagVolDivC1 == 50)
-		*tempMagVolDivC1 = 53;
-
-
-	CanvasTextSet(&g_sAddMinusC1, magVolDivC1);
-	PushButtonTextSet(&g_psTopButtons[0], magVolDivC1);
-	WidgetPaint((tWidget * ) &g_psTopButtons[0]);
-	WidgetPaint((tWidget * ) &g_sAddMinusC1);
+	// measurements at the old scale are not mixed with the new ones
+	StatReset();
+
+	ShowMagDiv(1);
+}
+
+// read value n of a ring. Values 2k and 2k+1 share bytes 3k to 3k+2, the first in the low 12 bits
+uint16_t RingGet(uint8_t *ring, uint32_t n){
+	uint8_t *p = ring + (n >> 1) * 3;
+
+	if(n & 1)
+		return (p[1] >> 4) | (p[2] << 4);
+	return p[0] | ((p[1] & 0x0F) << 8);
+}
+
+// write value n of a ring, leaving the value that shares its middle byte alone
+void RingPut(uint8_t *ring, uint32_t n, uint16_t Value){
+	uint8_t *p = ring + (n >> 1) * 3;
+
+	if(n & 1){
+		p[1] = (p[1] & 0x0F) | (Value << 4);
+		p[2] = Value >> 4;
+	}
+	else{
+		p[0] = Value;
+		p[1] = (p[1] & 0xF0) | ((Value >> 8) & 0x0F);
+	}
+}
+
+// read slot n of a ring as a pair. With both channels on the 3 bytes of a slot hold channel 1 in their
+// low 12 bits and channel 2 in their high 12 bits, with one channel on the slots are packed two to 3 bytes
+// and the value is returned for both channels. Inline, as drawing a frozen record reads one or two slots a pixel
+static inline uint32_t PairGet(uint8_t *ring, uint32_t n){
+	uint8_t *p = ring + (n >> (Interleaved ^ 1)) * 3;
+	uint32_t Word = p[0] | (p[1] << 8) | (p[2] << 16);
+
+	if(Interleaved == 1)
+		return (Word & 0xFFF) | ((Word & 0xFFF000) << 4);
+	Word = (Word >> ((n & 1) * 12)) & 0xFFF;
+	return Word * 0x10001;
+}
+
+// write slot n of a ring from a pair, with one channel on only the value of that channel is kept
+void PairPut(uint8_t *ring, uint32_t n, uint32_t Value){
+	uint8_t *p = ring + n * 3;
+	uint32_t Word = (Value & 0xFFF) | ((Value >> 4) & 0xFFF000);
+
+	if(Interleaved == 1){
+		p[0] = Word;
+		p[1] = Word >> 8;
+		p[2] = Word >> 16;
+	}
+	else if(Ch1on == 1)
+		RingPut(ring, n, Value & PAIR_LOW);
+	else
+		RingPut(ring, n, Value >> 16);
+}
+
+// portable version of PairSubSat without branching. Setting the top bit of every half of a lets the
+// subtraction leave it set exactly where that half of a is at least that half of b, and keeps the halves apart.
+// Taking one off each top bit left set turns it into a mask of the 15 bits below it
+uint32_t PairSubSatC(uint32_t a, uint32_t b){
+	uint32_t Diff = (a | 0x80008000) - b;
+	uint32_t Top = Diff & 0x80008000;
+
+	return Diff & (Top - (Top >> 15));
+}
+
+// lower and higher of each channel of two pairs. a - b stopped at 0 is what a is above b, so taking it
+// off a gives the lower value and adding it to b the higher, without a borrow or carry between the halves
+uint32_t PairMin(uint32_t a, uint32_t b){
+	return a - PairSubSat(a, b);
+}
+
+uint32_t PairMax(uint32_t a, uint32_t b){
+	return b + PairSubSat(a, b);
+}
+
+// compare both channels of a to levels b, bit 0 is set when channel 1 is at least its level and
+// bit 1 when channel 2 is. b - a stopped at 0 is 0 exactly where a is at least b
+uint8_t PairAtLeast(uint32_t a, uint32_t b){
+	uint32_t AtLeast = PairSubSat(0x00010001, PairSubSat(b, a));
+
+	return (AtLeast | (AtLeast >> 15)) & 3;
+}
+
+// carve the pool into a value ring and a low ring. With both channels on their values are interleaved
+// in every slot, with one channel on the slots only hold its values so the record is twice as long
+void SetupRings(void){
+	Interleaved = (Ch1on == 1 && Ch2on == 1);
+	if(Interleaved == 1)
+		RecordSize = MaxSize / 2;
+	else
+		RecordSize = MaxSize;
+	values = RingPool;
+	valuesLow = RingPool + PoolBytes / 2;
+	RingIndex = 0;
+
+	// a segmented sweep starts over in the ring of the first segment
+	Segment = 0;
+	ReArmMin = 0xFFFFFFFF;
+	ReArming = 0;
+	if(TriggerSweep == 3)
+		SelectSegment(0);
+
+	usprintf(DepthDisplay, "%dk pts", RecordSize >> 10);
+}
+
+// point the rings at the part of the pool that holds segment k
+void SelectSegment(uint8_t k){
+	uint32_t SegmentBytes = (Interleaved == 1) ? SegmentSize * 3 : SegmentSize / 2 * 3;
+
+	values = RingPool + k * SegmentBytes;
+	valuesLow = RingPool + PoolBytes / 2 + k * SegmentBytes;
+	RecordSize = SegmentSize;
+}
+
+// keep where the trigger of the filled segment is and re-arm right away in the ring of the next one,
+// once all segments are filled halt DMA and show the first one
+void NextSegment(uint32_t Stamp){
+	SegmentSlot[Segment] = TriggerSlot;
+	SegmentFrac[Segment] = TriggerFrac;
+	SegmentPre[Segment] = WindowPre;
+	SegmentEnd = Stamp;
+	Segment++;
+	if(Segment == MaxSegments){
+		Frozen = 1;
+		ShowSegment(0);
+		return;
+	}
+
+	SelectSegment(Segment);
+	RingIndex = 0;
+	ValidSlots = 0;
+	Armed = 0;
+	TriggerState = 0;
+	ReArming = 1;
+}
+
+// build the frame of segment k from its ring, each segment is shown as it was captured without averaging
+void ShowSegment(uint8_t k){
+	uint8_t Mode = CaptureMode;
+	char Time[12], ReArm[12];
+
+	Segment = k;
+	SelectSegment(k);
+	TriggerSlot = SegmentSlot[k];
+	TriggerFrac = SegmentFrac[k];
+	WindowPre = SegmentPre[k];
+	if(CaptureMode == 1 || CaptureMode == 2)
+		CaptureMode = 0;
+	j = 0;
+	CaptureWindow();
+	CaptureMode = Mode;
+	UpdateMeasurements();
+
+	FormatCycles(Time, SegmentStamp[k] - SegmentStamp[0]);
+	FormatCycles(ReArm, ReArmMin);
+	usprintf(SegmentDisplay, "Seg %d/%d  +%s  re-arm %s", k + 1, MaxSegments, Time, ReArm);
+
+	// let the main loop draw the segment once, the sweep stops again after it
+	stop = 0;
+}
+
+// Timer 1 count at which value f of a DMA buffer was sampled, counting back from when the buffer was full
+uint32_t SampleStamp(uint32_t *input, uint16_t f){
+	uint32_t Stamp = (input == inputs) ? BufferStamp[0] : BufferStamp[1];
+
+	return Stamp - (uint32_t)((MEM_BUFFER_SIZE - 1 - f) * secpixel[Time] * ui32SysClkFreq / (NumSkip + 1));
+}
+
+// start or stop the frequency counter, a new start takes one edge per interrupt until the interrupt takes more
+// itself or the frequency is known
+void CounterSetup(void){
+	TimerDisable(TIMER3_BASE, TIMER_A);
+	CounterStarted = 0;
+	CounterReady = 0;
+	CounterEdges = 1;
+	CounterNext = 1;
+	CounterLast = TimerValueGet(TIMER1_BASE, TIMER_A);
+	CounterMs = TickMs;
+	TimerPrescaleSet(TIMER3_BASE, TIMER_A, 0);
+	TimerLoadSet(TIMER3_BASE, TIMER_A, 1);
+	usprintf(CounterDisplay, "Counter  ---          ");
+	if(CounterOn == 1)
+		TimerEnable(TIMER3_BASE, TIMER_A);
+}
+
+// turn the periods and time of the last gate into a frequency and let Timer 3 interrupt about 8 times per gate.
+// Edges that arrive while the interrupt starts Timer 3 again are not counted. Every interrupt starts at an edge,
+// so each misses the whole number of periods that fit in the time Timer 3 is not counting, which only happens
+// at several MHz. The periods missed follow from the frequency of the counted edges
+void CounterUpdate(void){
+	double Periods = CounterPeriods, Dead = (double)CounterDeadTime / CounterParts;
+	uint32_t Edges;
+	char Text[16];
+
+	CounterReady = 0;
+	CounterFrequency = Periods * ui32SysClkFreq / CounterTime;
+	// a second pass settles the missed periods with the corrected frequency
+	for(i=0;i<2;i++){
+		Periods = CounterPeriods + CounterParts * floor(Dead * CounterFrequency / ui32SysClkFreq);
+		CounterFrequency = Periods * ui32SysClkFreq / CounterTime;
+	}
+
+	Edges = CounterFrequency * CounterGateMs / 8000;
+	if(Edges < 1)
+		Edges = 1;
+	if(Edges > CounterMaxEdges)
+		Edges = CounterMaxEdges;
+	CounterNext = Edges;
+
+	// seven digits keep a reading to about a ppm
+	FormatUnits(Text, CounterFrequency * 1000000 + 0.5, -6, 7, "Hz");
+	usprintf(CounterDisplay, "Counter  %s", Text);
+	DrawCounter();
+}
+
+// write the reading of the frequency counter at the bottom of the waveform
+void DrawCounter(void){
+	GrContextFontSet(&sContext, g_psFontCm12);
+	GrContextForegroundSet(&sContext, ClrRed);
+	GrContextBackgroundSet(&sContext, ClrBlack);
+	GrStringDraw(&sContext, CounterDisplay, -1, 8, 196, 1);
+}
+
+// write a number of Timer 1 counts as a time
+void FormatCycles(char *Text, uint32_t Cycles){
+	FormatUnits(Text, (uint64_t)Cycles * 1000 / (ui32SysClkFreq / 1000000), -9, 3, "s");
+}
+
+// write Value x 10^Exponent rounded to Digits significant digits, with the prefix that leaves 1 to 999 in front
+// of the point, such as "12.34kHz" for 12345678 mHz. Digits can be at most 9, and 0 rounds to six and writes
+// them up to the last that is not zero, such as "1V" for 1000 mV. Units without prefixes, % and deg, are
+// written as they are
+void FormatUnits(char *Text, uint64_t Value, int8_t Exponent, uint8_t Digits, const char *Unit){
+	uint8_t n = 1, Trim;
+	int8_t Group, Places, d;
+	uint32_t Shown;
+
+	if(Value == 0){
+		usprintf(Text, "0%s", Unit);
+		return;
+	}
+
+	// count the digits and round away those beyond the significant ones, which can carry into one more
+	while(n < 20 && Value >= PowersOfTen[n])
+		n++;
+	Trim = (Digits == 0);
+	if(Trim)
+		Digits = 6;
+	if(n > Digits){
+		Value = (Value + PowersOfTen[n - Digits] / 2) / PowersOfTen[n - Digits];
+		Exponent = Exponent + n - Digits;
+		n = Digits;
+		if(Value == PowersOfTen[n]){
+			Value = Value / 10;
+			Exponent++;
+		}
+	}
+	Shown = Value;
+	while(Trim && Shown % 10 == 0){
+		Shown = Shown / 10;
+		Exponent++;
+		n--;
+	}
+
+	// the prefix follows from the power of ten of the leading digit and sets how many digits follow the point
+	Group = Exponent + n - 1;
+	Group = (Group >= 0) ? Group / 3 : -((2 - Group) / 3);
+	if(Unit[0] == '%' || Unit[0] == 'd')
+		Group = 0;
+	if(Group < -3)
+		Group = -3;
+	if(Group > 3)
+		Group = 3;
+	Places = 3 * Group - Exponent;
+
+	d = n - 1 - Places;
+	if(d < 0)
+		d = 0;
+	for(;d >= 0 || d >= -Places;d--){
+		*Text++ = (d + Places >= 0) ? Shown / PowersOfTen[d + Places] % 10 + '0' : '0';
+		if(d == 0 && Places > 0)
+			*Text++ = '.';
+	}
+	usprintf(Text, "%s%s", UnitPrefixes[Group + 3], Unit);
+}
+
+// write the volts per division of a channel on its scale button and +/- box
+void ShowMagDiv(uint8_t Channel){
+	if(Channel == 1){
+		FormatUnits(magVolDivC1, mvpixel[Mag1] * 15 + 0.5f, -3, 0, "V/div");
+		CanvasTextSet(&g_sAddMinusC1, magVolDivC1);
+		PushButtonTextSet(&g_psTopButtons[0], magVolDivC1);
+		WidgetPaint((tWidget * ) &g_psTopButtons[0]);
+		WidgetPaint((tWidget * ) &g_sAddMinusC1);
+	}
+	else{
+		FormatUnits(magVolDivC2, mvpixel[Mag2] * 15 + 0.5f, -3, 0, "V/div");
+		CanvasTextSet(&g_sAddMinusC2, magVolDivC2);
+		PushButtonTextSet(&g_psTopButtons[1], magVolDivC2);
+		WidgetPaint((tWidget * ) &g_psTopButtons[1]);
+		WidgetPaint((tWidget * ) &g_sAddMinusC2);
+	}
+}
+
+// write the time per division on its scale button and +/- box. A division is 30 pixels
+void ShowTimeDiv(void){
+	FormatUnits(timVolDivC1, secpixel[Time] * 30 * 1000000000 + 0.5f, -9, 0, "s/div");
+	CanvasTextSet(&g_sAddMinusTime, timVolDivC1);
+	PushButtonTextSet(&g_psTopButtons[2], timVolDivC1);
+	WidgetPaint((tWidget * ) &g_psTopButtons[2]);
+	WidgetPaint((tWidget * ) &g_sAddMinusTime);
 }
 
 ////Minus function for magnitude division for channel 1/////////////
@@ -698,36 +1385,10 @@ void MinusMagDivC1(tWidget *psWidget) {
 	midlevel1 = 2048/pixel_divider1 + level1;
 	midlevel2 = 2048/pixel_divider2 + level2;
 
-	//25V to 20V
-	if (magVolDivC1[1] == 50 && magVolDivC1[2] == 53 && magVolDivC1[3] == 32) {
-		magVolDivC1[2] = 48;
-		tempMagVolDivC1 = magVolDivC1 + 1;
-	}
-	//1V to 500mV
-	else if (magVolDivC1[1] == 32 && magVolDivC1[2] == 49
-			&& magVolDivC1[3] == 32) {
-		tempMagVolDivC1 = magVolDivC1;
-		*tempMagVolDivC1 = 53;
-		magVolDivC1[1] = 48;
-		magVolDivC1[2] = 48;
-		magVolDivC1[3] = 109;
-	}
-	//stay at 20mv/div
-	else if (magVolDivC1[1] == 50 && magVolDivC1[3] == 109)
-		magVolDivC1[1] = 50;
-	else if (*tempMagVolDivC1 == 50)
-		*tempMagVolDivC1 = 49;
-	else if (*tempMagVolDivC1 == 49) {
-		*tempMagVolDivC1 = 32;
-		tempMagVolDivC1++;
-		*tempMagVolDivC1 = 53;
-	} else if (*tempMagVolDivC1 == 53)
-		*tempMagVolDivC1 = 50;
-
-	CanvasTextSet(&g_sAddMinusC1, magVolDivC1);
-	PushButtonTextSet(&g_psTopButtons[0], magVolDivC1);
-	WidgetPaint((tWidget * ) &g_psTopButtons[0]);
-	WidgetPaint((tWidget * ) &g_sAddMinusC1);
+	// measurements at the old scale are not mixed with the new ones
+	StatReset();
+
+	ShowMagDiv(1);
 }
 
 ////Add function for magnitude division for channel 2/////////////
@@ -746,37 +1407,10 @@ void AddMagDivC2(tWidget *psWidget) {
 	midlevel1 = 2048/pixel_divider1 + level1;
 	midlevel2 = 2048/pixel_divider2 + level2;
 
-	//make it 25V
-	if (magVolDivC2[1] == 50 && magVolDivC2[2] == 48 && magVolDivC2[3] == 32)
-		magVolDivC2[2] = 53;
-	//stay at 25V
-	else if (magVolDivC2[1] == 50 && magVolDivC2[2] == 53
-			&& magVolDivC2[3] == 32)
-		magVolDivC2[2] = 53;
-	// mV to V at 1 V
-	else if (magVolDivC2[0] == 53) {
-		tempMagVolDivC2 = magVolDivC2 + 2;
-		*tempMagVolDivC2 = 49;
-		magVolDivC2[0] = 32;
-		magVolDivC2[1] = 32;
-		magVolDivC2[3] = 32;
-	}
-	//every time from 5 to 10
-	else if (*tempMagVolDivC2 == 53) {
-		*tempMagVolDivC2 = 48;
-		tempMagVolDivC2--;
-		*tempMagVolDivC2 = 49;
-	}
-	//every time from 1 to 2
-	else if (*tempMagVolDivC2 == 49)
-		*tempMagVolDivC2 = 50;
-	//every time from 2 to 5
-	else if (*tempMagVolDivC2 == 50)
-		*tempMagVolDivC2 = 53;
-	CanvasTextSet(&g_sAddMinusC2, magVolDivC2);
-	PushButtonTextSet(&g_psTopButtons[1], magVolDivC2);
-	WidgetPaint((tWidget * ) &g_psTopButtons[1]);
-	WidgetPaint((tWidget * ) &g_sAddMinusC2);
+	// measurements at the old scale are not mixed with the new ones
+	StatReset();
+
+	ShowMagDiv(2);
 }
 
 ////Minus function for magnitude division for channel 2/////////////
@@ -795,41 +1429,26 @@ void MinusMagDivC2(tWidget *psWidget) {
 	midlevel1 = 2048/pixel_divider1 + level1;
 	midlevel2 = 2048/pixel_divider2 + level2;
 
-	//25V to 20V
-	if (magVolDivC2[1] == 50 && magVolDivC2[2] == 53 && magVolDivC2[3] == 32) {
-		magVolDivC2[2] = 48;
-		tempMagVolDivC2 = magVolDivC2 + 1;
-	}
-	//1V to 500mV
-	else if (magVolDivC2[1] == 32 && magVolDivC2[2] == 49
-			&& magVolDivC2[3] == 32) {
-		tempMagVolDivC2 = magVolDivC2;
-		*tempMagVolDivC2 = 53;
-		magVolDivC2[1] = 48;
-		magVolDivC2[2] = 48;
-		magVolDivC2[3] = 109;
-	}
-	//stay at 20mv/div
-	else if (magVolDivC2[1] == 50 && magVolDivC2[3] == 109)
-		magVolDivC2[1] = 50;
-	else if (*tempMagVolDivC2 == 50)
-		*tempMagVolDivC2 = 49;
-	else if (*tempMagVolDivC2 == 49) {
-		*tempMagVolDivC2 = 32;
-		tempMagVolDivC2++;
-		*tempMagVolDivC2 = 53;
-	} else if (*tempMagVolDivC2 == 53)
-		*tempMagVolDivC2 = 50;
-
-	CanvasTextSet(&g_sAddMinusC2, magVolDivC2);
-	PushButtonTextSet(&g_psTopButtons[1], magVolDivC2);
-	WidgetPaint((tWidget * ) &g_psTopButtons[1]);
-	WidgetPaint((tWidget * ) &g_sAddMinusC2);
+	// measurements at the old scale are not mixed with the new ones
+	StatReset();
+
+	ShowMagDiv(2);
 }
 
 ////Add function for time division for channel 1 & 2 /////////////
 void AddTimeDiv(tWidget *psWidget) {
 
+	// step to the next segment or zoom out of a frozen record instead of changing the time scale
+	if(Frozen == 1 && TriggerSweep == 3){
+		if(Segment < MaxSegments - 1)
+			ShowSegment(Segment + 1);
+		return;
+	}
+	if(Frozen == 1){
+		ZoomRecord(1);
+		return;
+	}
+
 	// make sure time division variable doesn't go out of bounds
 	if(Time == 28)
 		Time = 28;
@@ -842,59 +1461,27 @@ void AddTimeDiv(tWidget *psWidget) {
 	// update EPI clock rate with new EPIDivide
 	EPIDividerSet(EPI0_BASE, EPIDivide);
 
-	//make it 50 s
-	if (timVolDivC1[1] == 53 && timVolDivC1[2] == 48 && timVolDivC1[3] == 32)
-		timVolDivC1[2] = 48;
-	//stay at 50 s
-	else if (timVolDivC1[1] == 53 && timVolDivC1[2] == 48
-			&& timVolDivC1[3] == 32)
-		timVolDivC1[1] =53 ;
-
-	// from 500 ns to 1 us
-	else if(timVolDivC1[0]==53 && timVolDivC1[3]==110){
-		tempTimVolDivC1=timVolDivC1+2;
-		*tempTimVolDivC1=49;
-		timVolDivC1[0]=32;
-		timVolDivC1[1]=32;
-		timVolDivC1[3]=117;
-	}
-	// from 500 us to 1 ms
-	else if(timVolDivC1[0]==53 && timVolDivC1[3]==117){
-		tempTimVolDivC1=timVolDivC1+2;
-		*tempTimVolDivC1=49;
-		timVolDivC1[0]=32;
-		timVolDivC1[1]=32;
-		timVolDivC1[3]=109;
-	}
-	// from 500 ms to 1 s
-	else if(timVolDivC1[0]==53 && timVolDivC1[3]==109){
-		tempTimVolDivC1=timVolDivC1+2;
-		*tempTimVolDivC1=49;
-		timVolDivC1[0]=32;
-		timVolDivC1[1]=32;
-		timVolDivC1[3]=32;
-	}
-	//every time from 5 to 10
-	else if (*tempTimVolDivC1 == 53) {
-		*tempTimVolDivC1 = 48;
-		tempTimVolDivC1--;
-		*tempTimVolDivC1 = 49;
-	}
-	//every time from 1 to 2
-	else if (*tempTimVolDivC1 == 49)
-		*tempTimVolDivC1 = 50;
-	//every time from 2 to 5
-	else if (*tempTimVolDivC1 == 50)
-		*tempTimVolDivC1 = 53;
-	CanvasTextSet(&g_sAddMinusTime, timVolDivC1);
-	PushButtonTextSet(&g_psTopButtons[2], timVolDivC1);
-	WidgetPaint((tWidget * ) &g_psTopButtons[2]);
-	WidgetPaint((tWidget * ) &g_sAddMinusTime);
+	// values already in the ring and the statistics were taken at the old time scale
+	ArmTrigger();
+	StatReset();
+
+	ShowTimeDiv();
 }
 
 ////Minus function for time division for channel 1 & 2 /////////////
 void MinusTimeDiv(tWidget *psWidget) {
 
+	// step to the previous segment or zoom into a frozen record instead of changing the time scale
+	if(Frozen == 1 && TriggerSweep == 3){
+		if(Segment > 0)
+			ShowSegment(Segment - 1);
+		return;
+	}
+	if(Frozen == 1){
+		ZoomRecord(-1);
+		return;
+	}
+
 	// make sure time division variable doesn't go out of bounds
 	if(Time == 6)
 		Time = 6;
@@ -907,53 +1494,11 @@ void MinusTimeDiv(tWidget *psWidget) {
 	// update EPI clock rate based on new EPIDivide
 	EPIDividerSet(EPI0_BASE, EPIDivide);
 
-	if (timVolDivC1[0] == 32 && timVolDivC1[1] == 32
-			&& timVolDivC1[2] == 49&& timVolDivC1[3] == 32) {
-		tempTimVolDivC1 = timVolDivC1;
-		*tempTimVolDivC1 = 53;
-		timVolDivC1[1] = 48;
-		timVolDivC1[2] = 48;
-		timVolDivC1[3] = 109;
-	}
-	//1ms to 500us
-	else if  (timVolDivC1[0] == 32 && timVolDivC1[1] == 32
-			&& timVolDivC1[2] == 49 && timVolDivC1[3] == 109)  {
-		tempTimVolDivC1 = timVolDivC1;
-		*tempTimVolDivC1 = 53;
-		timVolDivC1[1] = 48;
-		timVolDivC1[2] = 48;
-		timVolDivC1[3] = 117;
-	}
-	//1us to 500ns
-	else if  (timVolDivC1[0] == 32 && timVolDivC1[1] == 32
-			&& timVolDivC1[2] == 49 && timVolDivC1[3] == 117)  {
-		tempTimVolDivC1 = timVolDivC1;
-		*tempTimVolDivC1 = 53;
-		timVolDivC1[1] = 48;
-		timVolDivC1[2] = 48;
-		timVolDivC1[3] = 110;
-	}
-	//stay at 2us/div
-	else if (timVolDivC1[2] == 50 && timVolDivC1[3] == 117)
-		timVolDivC1[2] = 50;
-
-	//from 5 to 2
-	else if (*tempTimVolDivC1 == 53)
-		*tempTimVolDivC1 = 50;
-	//from 2 to 1
-	else if (*tempTimVolDivC1 == 50)
-		*tempTimVolDivC1 = 49;
-   //from 1 to 0
-	else if (*tempTimVolDivC1 == 49) {
-		*tempTimVolDivC1 = 32;
-		tempTimVolDivC1++;
-		*tempTimVolDivC1 = 53;
-	}
+	// values already in the ring and the statistics were taken at the old time scale
+	ArmTrigger();
+	StatReset();
 
-	CanvasTextSet(&g_sAddMinusTime, timVolDivC1);
-	PushButtonTextSet(&g_psTopButtons[2], timVolDivC1);
-	WidgetPaint((tWidget * ) &g_psTopButtons[2]);
-	WidgetPaint((tWidget * ) &g_sAddMinusTime);
+	ShowTimeDiv();
 }
 
 
@@ -1036,42 +1581,38 @@ void AddMinusFunctionTime(tWidget *pWidget) {
 	}
 
 }
-///Not Using////////////////////////////////////////////
+// the frequency button of channel 1 turns the frequency counter on and off
 void DRadioFreMagnitudeC1(tWidget *pWidgetR) {
-	ButtonTF = !ButtonTF;
-	if (ButtonTF) {
-
-	} else {
-		ClrMyWidget();
-	}
-
+	CounterOn = !CounterOn;
+	CounterSetup();
+	if(CounterOn == 1)
+		DrawCounter();
+	else
+		WidgetPaint((tWidget *) &g_sWaveform);
 }
+// the frequency button of channel 2 shows and hides the statistics, hiding them starts them over
 void DRadioFreMagnitudeC2(tWidget *pWidgetR) {
-	ButtonTF = !ButtonTF;
-	if (ButtonTF) {
-
-	} else {
+	StatsOn = !StatsOn;
+	if(StatsOn == 1){
+		DrawStats();
+	}
+	else{
+		StatReset();
 		ClrMyWidget();
 	}
-
 }
+// the voltage buttons step through the measurements of their channel, the last frame's are shown right away
 void DRadioVolMagnitudeC1(tWidget *pWidgetR) {
-	ButtonTF = !ButtonTF;
-	if (ButtonTF) {
-
-	} else {
-		ClrMyWidget();
-	}
-
+	MeasureSelect[0] = (MeasureSelect[0] + 1) % MeasureKinds;
+	FormatMeasure(MeasureDisplay1, 0);
+	PushButtonTextSet(&g_psBotButtons[2], (MeasureSelect[0] == MEAS_VPP) ? MagDisplay1 : MeasureDisplay1);
+	WidgetPaint((tWidget * ) &g_psBotButtons[2]);
 }
 void DRadioVolMagnitudeC2(tWidget *pWidgetR) {
-	ButtonTF = !ButtonTF;
-	if (ButtonTF) {
-
-	} else {
-		ClrMyWidget();
-	}
-
+	MeasureSelect[1] = (MeasureSelect[1] + 1) % MeasureKinds;
+	FormatMeasure(MeasureDisplay2, 1);
+	PushButtonTextSet(&g_psBotButtons[3], (MeasureSelect[1] == MEAS_VPP) ? MagDisplay2 : MeasureDisplay2);
+	WidgetPaint((tWidget * ) &g_psBotButtons[3]);
 }
 ///////////////////////////////////////////////////////////////
 ///Display channels select options/////////////////////////////
@@ -1137,10 +1678,20 @@ void TriggerSelectRadioBtns(tWidget *psWidget, uint32_t bSelected){
 	      }
 	  }
 
+	  // the cursors stay on the waveform until another trigger setting is picked
+	  WidgetRemove((tWidget *) &g_sCursorSliderTime1);
+	  WidgetRemove((tWidget *) &g_sCursorSliderTime2);
+	  WidgetRemove((tWidget *) &g_sCursorSliderLevel1);
+	  WidgetRemove((tWidget *) &g_sCursorSliderLevel2);
+	  WidgetRemove((tWidget *) &g_sQualifierSlider);
+	  if(ui32Idx != 5 && CursorsOn == 1)
+		  HideCursors();
+
 	  if(ui32Idx==0){
 		  WidgetAdd(WIDGET_ROOT, (tWidget *) &g_sContainerTriggerSource);
 		  WidgetPaint((tWidget * )&g_sContainerTriggerSource);
 		  WidgetRemove((tWidget *) &g_sContainerTriggerMode);
+		  WidgetRemove((tWidget *) &g_sContainerTriggerSweep);
 		  WidgetRemove((tWidget *) &g_sTriggerSliderVertical);
 		  WidgetRemove((tWidget *) &g_sTriggerSliderHorizontal);
 
@@ -1148,8 +1699,15 @@ void TriggerSelectRadioBtns(tWidget *psWidget, uint32_t bSelected){
 	  else if(ui32Idx==1){
 		  WidgetAdd(WIDGET_ROOT, (tWidget *) &g_sTriggerSliderVertical);
 		  WidgetPaint((tWidget * )&g_sTriggerSliderVertical);
+		  // a pattern source also sets the level channel 2 is qualified on
+		  if(TriggerSource >= 3){
+			  WidgetAdd(WIDGET_ROOT, (tWidget *) &g_sQualifierSlider);
+			  WidgetPaint((tWidget * )&g_sQualifierSlider);
+			  DrawQualifier();
+		  }
 		  WidgetRemove((tWidget *) &g_sContainerTriggerSource);
 		  WidgetRemove((tWidget *) &g_sContainerTriggerMode);
+		  WidgetRemove((tWidget *) &g_sContainerTriggerSweep);
 		  WidgetRemove((tWidget *) &g_sTriggerSliderHorizontal);
 	  }
 	  else if(ui32Idx==2){
@@ -1157,17 +1715,45 @@ void TriggerSelectRadioBtns(tWidget *psWidget, uint32_t bSelected){
 		  WidgetPaint((tWidget * )&g_sTriggerSliderHorizontal);
 		  WidgetRemove((tWidget *) &g_sContainerTriggerSource);
 		  WidgetRemove((tWidget *) &g_sContainerTriggerMode);
+		  WidgetRemove((tWidget *) &g_sContainerTriggerSweep);
 		  WidgetRemove((tWidget *) &g_sTriggerSliderVertical);
 
 	  	  }
-	  else{
+	  else if(ui32Idx==3){
 		  WidgetAdd(WIDGET_ROOT, (tWidget *) &g_sContainerTriggerMode);
 		  WidgetPaint((tWidget * )&g_sContainerTriggerMode);
 		  WidgetRemove((tWidget *) &g_sContainerTriggerSource);
+		  WidgetRemove((tWidget *) &g_sContainerTriggerSweep);
 		  WidgetRemove((tWidget *) &g_sTriggerSliderVertical);
 		  WidgetRemove((tWidget *) &g_sTriggerSliderHorizontal);
 
 	  }
+	  else if(ui32Idx==4){
+		  WidgetAdd(WIDGET_ROOT, (tWidget *) &g_sContainerTriggerSweep);
+		  WidgetPaint((tWidget * )&g_sContainerTriggerSweep);
+		  WidgetRemove((tWidget *) &g_sContainerTriggerSource);
+		  WidgetRemove((tWidget *) &g_sContainerTriggerMode);
+		  WidgetRemove((tWidget *) &g_sTriggerSliderVertical);
+		  WidgetRemove((tWidget *) &g_sTriggerSliderHorizontal);
+
+	  }
+	  else{
+		  CursorsOn = 1;
+		  WidgetRemove((tWidget *) &g_sContainerTriggerSource);
+		  WidgetRemove((tWidget *) &g_sContainerTriggerMode);
+		  WidgetRemove((tWidget *) &g_sContainerTriggerSweep);
+		  WidgetRemove((tWidget *) &g_sTriggerSliderVertical);
+		  WidgetRemove((tWidget *) &g_sTriggerSliderHorizontal);
+		  WidgetAdd(WIDGET_ROOT, (tWidget *) &g_sCursorSliderTime1);
+		  WidgetAdd(WIDGET_ROOT, (tWidget *) &g_sCursorSliderTime2);
+		  WidgetAdd(WIDGET_ROOT, (tWidget *) &g_sCursorSliderLevel1);
+		  WidgetAdd(WIDGET_ROOT, (tWidget *) &g_sCursorSliderLevel2);
+		  WidgetPaint((tWidget * )&g_sCursorSliderTime1);
+		  WidgetPaint((tWidget * )&g_sCursorSliderTime2);
+		  WidgetPaint((tWidget * )&g_sCursorSliderLevel1);
+		  WidgetPaint((tWidget * )&g_sCursorSliderLevel2);
+		  DrawCursors();
+	  }
 }
 
 void TriggerModeSelect(tWidget *psWidget, uint32_t bSelected){
@@ -1210,11 +1796,56 @@ void TriggerSourceSelect(tWidget *psWidget, uint32_t bSelected){
 /////Source 1/////////////////////////
 		  if(ui32Idx==0){
 			  TriggerSource = 1;
+			  TriggerPattern = 0x0A; // channel 1 above level
 
 		  }
 /////Source 2/////////////////////////
 		  else  if(ui32Idx==1) {
 			  TriggerSource = 2;
+			  TriggerPattern = 0x0C; // channel 2 above level
+		  }
+/////Pattern 1 AND 2//////////////////
+		  else  if(ui32Idx==2) {
+			  TriggerSource = 3;
+			  TriggerPattern = 0x08; // both channels above their levels
+		  }
+/////Pattern 1 OR 2///////////////////
+		  else  if(ui32Idx==3) {
+			  TriggerSource = 4;
+			  TriggerPattern = 0x0E; // either channel above its level
+		  }
+}
+
+void TriggerSweepSelect(tWidget *psWidget, uint32_t bSelected){
+	uint32_t ui32Idx;
+		  for(ui32Idx = 0; ui32Idx < NUM_RADIO_BUTTONS_TriggerSweep; ui32Idx++)
+		  {
+		      if(psWidget == (tWidget *)(g_psRadioBtnTriggerSweep + ui32Idx))
+		      {
+		          break;
+		      }
+		  }
+		  if(ui32Idx == NUM_RADIO_BUTTONS_TriggerSweep)
+		    {
+		        return;
+		    }
+
+		  ResumeAcquisition();
+		  // segments use their own short rings, so the pool is carved again going into or out of them
+		  if(TriggerSweep == 3 || ui32Idx == 3){
+			  TriggerSweep = ui32Idx;
+			  SetupRings();
+			  ArmTrigger();
+			  stop = (TriggerSweep == 3);
+		  }
+		  TriggerSweep = ui32Idx;
+		  TriggerStart = 0;
+		  ArmedMs = TickMs;
+
+/////Single: arm once and keep the display running until the frame is drawn/////
+		  if(TriggerSweep == 2){
+			  SingleArmed = 1;
+			  stop = 0;
 		  }
 }
 
@@ -1258,6 +1889,12 @@ void ChannelSelectRadioBtns(tWidget *psWidget, uint32_t bSelected){
 		  WidgetPaint((tWidget * )&g_sC2Slider);
 	  }
 
+	  // give the memory of a channel that was turned off to the other one, and start the statistics over
+	  ResumeAcquisition();
+	  SetupRings();
+	  ArmTrigger();
+	  StatReset();
+	  WidgetPaint((tWidget * )&g_sRecordDepth);
 }
 
 
@@ -1303,6 +1940,29 @@ void AcquireSelectRadioBtns(tWidget *psWidget, uint32_t bSelected){
 		  else if(ui32Idx==1){
 			  CaptureMode = 1;
 		  }
+		  // exponential average with a weight of 1/4, 1/8 or 1/16
+		  else if(ui32Idx < 5){
+			  CaptureMode = 2;
+			  ExpShift = ui32Idx;
+		  }
+		  else if(ui32Idx==5){
+			  CaptureMode = 3;
+		  }
+		  else if(ui32Idx==6){
+			  CaptureMode = 4;
+		  }
+		  // envelope that is kept until the mode changes or that starts over every 100 frames
+		  else if(ui32Idx==7){
+			  CaptureMode = 5;
+			  EnvelopeLimit = 0;
+		  }
+		  else if(ui32Idx==8){
+			  CaptureMode = 5;
+			  EnvelopeLimit = 100;
+		  }
+		  // start over with empty sums for averaging and empty statistics
+		  ArmTrigger();
+		  StatReset();
 
 
 }
@@ -1353,6 +2013,8 @@ void DWaveForm(tWidget *pWidgetR, tContext *psContext) {
 		if(Ch1on == 1){
 			Ch1off = 0;
 			GrLineDraw(&sContext,x-1,old1[x-1],x,old1[x]);
+			if(bandlow1[x] != bandhigh1[x] && stop == 0)
+				GrLineDrawV(&sContext,x,bandlow1[x],bandhigh1[x]);
 		}
 		else if(Ch1on == 0 && Ch1off == 0){
 			  ClrMyWidget();
@@ -1361,18 +2023,28 @@ void DWaveForm(tWidget *pWidgetR, tContext *psContext) {
 		if(Ch2on == 1){
 			Ch2off = 0;
 			GrLineDraw(&sContext,x-1,old2[x-1],x,old2[x]);
+			if(bandlow2[x] != bandhigh2[x] && stop == 0)
+				GrLineDrawV(&sContext,x,bandlow2[x],bandhigh2[x]);
 		}
 		else if(Ch2on == 0 && Ch2off == 0){
 			  ClrMyWidget();
 			  Ch2off = 1;
 		}
+	}
 
+	// the histogram goes under the signals, so it is drawn once the previous signals are removed
+	if(HistogramOn != 0)
+		DrawHistogram();
+
+	for (x = 7; x < SERIES_LENGTH; x++) {
 		// if channel 2 should be on, draw lines to create signal
 		if(Ch2on == 1){
 			GrContextForegroundSet(&sContext, ClrYellow);
 			// if stopped, don't draw an updated signal
 			if(stop == 1){
 				GrLineDraw(&sContext,x-1,old2[x-1],x,old2[x]);
+				if(bandlow2[x] != bandhigh2[x])
+					GrLineDrawV(&sContext,x,bandlow2[x],bandhigh2[x]);
 			}
 			else{
 				// determine which pixel values will be out of bounds
@@ -1432,6 +2104,15 @@ void DWaveForm(tWidget *pWidgetR, tContext *psContext) {
 				else{
 					GrLineDraw(&sContext,x-1,old2[x-1]=210,x,210);
 				}
+
+				// draw the band between the lowest and highest values of the pixel
+				if(DrawBand == 1){
+					bandlow2[x] = PixelRow(pixelsLow2[x], midlevel2, pixel_divider2);
+					bandhigh2[x] = PixelRow(pixels2[x], midlevel2, pixel_divider2);
+					GrLineDrawV(&sContext,x,bandlow2[x],bandhigh2[x]);
+				}
+				else
+					bandhigh2[x] = bandlow2[x];
 			}
 		}
 
@@ -1441,6 +2122,8 @@ void DWaveForm(tWidget *pWidgetR, tContext *psContext) {
 			// if stopped, don't update signal
 			if(stop == 1){
 				GrLineDraw(&sContext,x-1,old1[x-1],x,old1[x]);
+				if(bandlow1[x] != bandhigh1[x])
+					GrLineDrawV(&sContext,x,bandlow1[x],bandhigh1[x]);
 			}
 			else{
 				// determine whici pixel values go out of bounds
@@ -1500,6 +2183,15 @@ void DWaveForm(tWidget *pWidgetR, tContext *psContext) {
 				else{
 					GrLineDraw(&sContext,x-1,old1[x-1]=210,x,210);
 				}
+
+				// draw the band between the lowest and highest values of the pixel
+				if(DrawBand == 1){
+					bandlow1[x] = PixelRow(pixelsLow[x], midlevel1, pixel_divider1);
+					bandhigh1[x] = PixelRow(pixels[x], midlevel1, pixel_divider1);
+					GrLineDrawV(&sContext,x,bandlow1[x],bandhigh1[x]);
+				}
+				else
+					bandhigh1[x] = bandlow1[x];
 			}
 		}
 
@@ -1522,6 +2214,28 @@ void DWaveForm(tWidget *pWidgetR, tContext *psContext) {
 			GrPixelDraw(&sContext, x, y);
 	}
 
+	// name the segment shown once a segmented sweep is done
+	if(TriggerSweep == 3 && Frozen == 1){
+		GrContextFontSet(&sContext, g_psFontCm12);
+		GrContextForegroundSet(&sContext, ClrWhite);
+		GrContextBackgroundSet(&sContext, ClrBlack);
+		GrStringDraw(&sContext, SegmentDisplay, -1, 8, 31, 1);
+	}
+	if(CounterOn == 1)
+		DrawCounter();
+	if(StatsOn == 1)
+		DrawStats();
+	if(HistogramOn != 0){
+		GrContextFontSet(&sContext, g_psFontCm12);
+		GrContextForegroundSet(&sContext, ClrGray);
+		GrContextBackgroundSet(&sContext, ClrBlack);
+		GrStringDraw(&sContext, HistogramDisplay, -1, 8, 183, 1);
+	}
+	DrawTrend();
+	if(CursorsOn == 1)
+		DrawCursors();
+	if(TriggerSource >= 3)
+		DrawQualifier();
 }
 
 void TriggerFunction(tWidget *pWidget){
@@ -1554,9 +2268,47 @@ OnSliderChangeVertical(tWidget *psWidget, int32_t i32Value){
 	TriggerLevel = (midlevel1 - (240 - (uint16_t) i32Value));
 
 }
+// set the qualifier level from a screen row on the scale of channel 2, a row above every value never qualifies
+void OnSliderChangeQualifier(tWidget *psWidget, int32_t i32Value){
+	int32_t Level = (midlevel2 - (240 - i32Value)) * pixel_divider2 + 0.5f;
+
+	if(Level < 0)
+		Level = 0;
+	if(Level > 4096)
+		Level = 4096;
+	QualifierLevel = Level;
+	DrawQualifier();
+}
+
+// write the level channel 2 has to be above for a pattern trigger at the top right of the waveform
+void DrawQualifier(void){
+	char Volts[12];
+
+	FormatValue(Volts, ((int16_t)QualifierLevel - 2048) / pixel_divider2 * mvpixel[Mag2] / 1000, MEAS_VPP);
+	usprintf(QualifierDisplay, "2 > %s   ", Volts);
+	GrContextFontSet(&sContext, g_psFontCm12);
+	GrContextForegroundSet(&sContext, ClrYellow);
+	GrContextBackgroundSet(&sContext, ClrBlack);
+	GrStringDraw(&sContext, QualifierDisplay, -1, 224, 31, 1);
+}
+
 void OnSliderChangeHorizontal(tWidget *psWidget, int32_t i32Value){
 
-TriggerPosition = i32Value;
+if(i32Value > SERIES_LENGTH)
+	i32Value = SERIES_LENGTH;
+
+// pick a segment of a finished segmented sweep from left to right
+if(Frozen == 1 && TriggerSweep == 3){
+	ShowSegment(i32Value * MaxSegments / (SERIES_LENGTH + 1));
+}
+// pan through a frozen record from its start to its end
+else if(Frozen == 1){
+	ViewStart = (RecordSize - (SERIES_LENGTH << ViewZoom)) * i32Value / SERIES_LENGTH;
+	RenderRecord();
+}
+// the trigger position can be anywhere from the left edge to the right edge of the display
+else
+	TriggerPosition = i32Value;
 
 }
 
@@ -1578,43 +2330,193 @@ midlevel2 = 2048/pixel_divider2 + desiredlevel2;
 
 }
 
-// determine whether to keep signal updating
-void RunStop(tWidget *psWidget){
-	if(stop == 0)
-		stop = 1;
-	else
-		stop = 0;
+// move a cursor, repainting only the column or row it leaves instead of the whole waveform
+void OnSliderChangeCursor(tWidget *psWidget, int32_t i32Value){
+	if(psWidget == (tWidget *) &g_sCursorSliderTime1 || psWidget == (tWidget *) &g_sCursorSliderTime2){
+		i = (psWidget == (tWidget *) &g_sCursorSliderTime2);
+		RestoreColumn(CursorColumn[i]);
+		CursorColumn[i] = i32Value;
+	}
+	else{
+		i = (psWidget == (tWidget *) &g_sCursorSliderLevel2);
+		RestoreRow(CursorRow[i]);
+		CursorRow[i] = 240 - i32Value;
+	}
+	DrawCursors();
 }
 
-// remove DC offset for testing purposes
-void OffSet(tWidget *psWidget){
-	CalibrateOffset();
+// draw the cursors and write the time between the time cursors, its inverse and the voltage between the voltage
+// cursors on the scale of channel 1, or of channel 2 when only it is on. A pixel of a frozen record spans
+// 1 << ViewZoom ring slots, and a ring slot holds one pixel of the captured frame however many values it skipped
+void DrawCursors(void){
+	int16_t Columns = CursorColumn[1] - CursorColumn[0], Rows = CursorRow[1] - CursorRow[0];
+	float Seconds, mV;
+	char Delta[12], Rate[12], Volts[12];
+
+	GrContextForegroundSet(&sContext, ClrCyan);
+	for(i=0;i<2;i++){
+		GrLineDrawV(&sContext, CursorColumn[i], 29, 210);
+		GrLineDrawH(&sContext, 7, 316, CursorRow[i]);
+	}
+
+	if(Columns < 0)
+		Columns = -Columns;
+	if(Rows < 0)
+		Rows = -Rows;
+	Seconds = Columns * secpixel[Time];
+	if(Frozen == 1)
+		Seconds = Seconds * (1 << ViewZoom);
+	mV = Rows * mvpixel[(Ch1on == 1) ? Mag1 : Mag2];
+	FormatUnits(Delta, Seconds * 1000000000 + 0.5f, -9, 3, "s");
+	if(Seconds > 0)
+		FormatUnits(Rate, 1000 / Seconds + 0.5f, -3, 3, "Hz");
+	else
+		usprintf(Rate, "--");
+	FormatUnits(Volts, mV * 1000 + 0.5f, -6, 3, "V");
+	usprintf(CursorDisplay, "dt %s  1/dt %s  dV %s   ", Delta, Rate, Volts);
+	GrContextFontSet(&sContext, g_psFontCm12);
+	GrContextForegroundSet(&sContext, ClrCyan);
+	GrContextBackgroundSet(&sContext, ClrBlack);
+	GrStringDraw(&sContext, CursorDisplay, -1, 24, 157, 1);
 }
 
-//
-int main(void) {
-	// Set clock frequency to 120 MHz
-	ui32SysClkFreq = SysCtlClockFreqSet((SYSCTL_XTAL_25MHZ |
-	SYSCTL_OSC_MAIN | SYSCTL_USE_PLL |
-	SYSCTL_CFG_VCO_480), 120000000);
-	tempMagVolDivC1 = magVolDivC1 + 1;
-	tempMagVolDivC2 = magVolDivC2 + 1;
-	tempTimVolDivC1 = timVolDivC1 + 2;
+// take the cursors and their readout off the waveform
+void HideCursors(void){
+	tRectangle Rect;
 
+	CursorsOn = 0;
+	for(i=0;i<2;i++){
+		RestoreColumn(CursorColumn[i]);
+		RestoreRow(CursorRow[i]);
+	}
+	Rect.i16XMin = 24;
+	Rect.i16YMin = 157;
+	Rect.i16XMax = 296;
+	Rect.i16YMax = 170;
+	GrContextForegroundSet(&sContext, ClrBlack);
+	GrRectFill(&sContext, &Rect);
+}
 
+// paint a column of the waveform as DWaveForm last left it: black, the traces and bands that pass through it,
+// the grid and the center dot
+void RestoreColumn(int16_t Column){
+	int16_t Row, n;
 
-	Kentec320x240x16_SSD2119Init(ui32SysClkFreq);
-	GrContextInit(&sContext, &g_sKentec320x240x16_SSD2119);
-	TouchScreenInit(ui32SysClkFreq);
-	TouchScreenCallbackSet(WidgetPointerMessage);
+	GrContextForegroundSet(&sContext, ClrBlack);
+	GrLineDrawV(&sContext, Column, 29, 210);
+	for(n=Column;n<=Column+1;n++){
+		if(n < 7 || n > 316)
+			continue;
+		if(Ch2on == 1){
+			GrContextForegroundSet(&sContext, ClrYellow);
+			GrLineDraw(&sContext, n-1, old2[n-1], n, old2[n]);
+			if(bandlow2[n] != bandhigh2[n])
+				GrLineDrawV(&sContext, n, bandlow2[n], bandhigh2[n]);
+		}
+		if(Ch1on == 1){
+			GrContextForegroundSet(&sContext, ClrRed);
+			GrLineDraw(&sContext, n-1, old1[n-1], n, old1[n]);
+			if(bandlow1[n] != bandhigh1[n])
+				GrLineDrawV(&sContext, n, bandlow1[n], bandhigh1[n]);
+		}
+	}
+	GrContextForegroundSet(&sContext, ClrWhite);
+	if(Column % 4 == 0){
+		for(Row = 29; Row <= 210; Row += 15)
+			GrPixelDraw(&sContext, Column, Row);
+	}
+	if(Column % 40 == 0){
+		for(Row = 29; Row <= 210; Row += 4)
+			GrPixelDraw(&sContext, Column, Row);
+	}
+	if(Column >= 157 && Column <= 163)
+		GrCircleFill(&sContext, 160, 119, 3);
+}
 
-////Intro pictures//////////////////////////
-	GrImageDraw(&sContext, g_pui8Image, 0, 0);
-	GrFlush(&sContext);
-	SysCtlDelay(ui32SysClkFreq);
+// paint a row of the waveform between the cursor ends as DWaveForm last left it, redrawing only the pieces of
+// trace and band that cross the row
+void RestoreRow(int16_t Row){
+	int16_t Column;
 
-	GrImageDraw(&sContext, g_pui9Image, 0, 0);
-	GrFlush(&sContext);
+	GrContextForegroundSet(&sContext, ClrBlack);
+	GrLineDrawH(&sContext, 7, 316, Row);
+	for(Column = 7; Column <= 317; Column++){
+		if(Ch2on == 1){
+			GrContextForegroundSet(&sContext, ClrYellow);
+			if((old2[Column-1] - Row) * (old2[Column] - Row) <= 0)
+				GrLineDraw(&sContext, Column-1, old2[Column-1], Column, old2[Column]);
+			if(bandlow2[Column] != bandhigh2[Column] && (bandlow2[Column] - Row) * (bandhigh2[Column] - Row) <= 0)
+				GrLineDrawV(&sContext, Column, bandlow2[Column], bandhigh2[Column]);
+		}
+		if(Ch1on == 1){
+			GrContextForegroundSet(&sContext, ClrRed);
+			if((old1[Column-1] - Row) * (old1[Column] - Row) <= 0)
+				GrLineDraw(&sContext, Column-1, old1[Column-1], Column, old1[Column]);
+			if(bandlow1[Column] != bandhigh1[Column] && (bandlow1[Column] - Row) * (bandhigh1[Column] - Row) <= 0)
+				GrLineDrawV(&sContext, Column, bandlow1[Column], bandhigh1[Column]);
+		}
+	}
+	GrContextForegroundSet(&sContext, ClrWhite);
+	if((Row - 29) % 15 == 0){
+		for(Column = 8; Column <= 316; Column += 4)
+			GrPixelDraw(&sContext, Column, Row);
+	}
+	if((Row - 29) % 4 == 0){
+		for(Column = 40; Column <= 316; Column += 40)
+			GrPixelDraw(&sContext, Column, Row);
+	}
+	if(Row >= 116 && Row <= 122)
+		GrCircleFill(&sContext, 160, 119, 3);
+}
+
+// determine whether to keep signal updating
+void RunStop(tWidget *psWidget){
+	// in segmented sweep mode the button starts another sequence without drawing until it is done
+	if(TriggerSweep == 3){
+		ResumeAcquisition();
+		SetupRings();
+		ArmTrigger();
+		stop = 1;
+	}
+	// in single sweep mode the button arms the trigger for another sweep
+	else if(TriggerSweep == 2){
+		ResumeAcquisition();
+		TriggerStart = 0;
+		SingleArmed = 1;
+		stop = 0;
+	}
+	else if(stop == 0)
+		stop = 1;
+	else
+		stop = 0;
+}
+
+// remove DC offset for testing purposes
+void OffSet(tWidget *psWidget){
+	CalibrateOffset();
+}
+
+//
+int main(void) {
+	// Set clock frequency to 120 MHz
+	ui32SysClkFreq = SysCtlClockFreqSet((SYSCTL_XTAL_25MHZ |
+	SYSCTL_OSC_MAIN | SYSCTL_USE_PLL |
+	SYSCTL_CFG_VCO_480), 120000000);
+
+
+
+	Kentec320x240x16_SSD2119Init(ui32SysClkFreq);
+	GrContextInit(&sContext, &g_sKentec320x240x16_SSD2119);
+	TouchScreenInit(ui32SysClkFreq);
+	TouchScreenCallbackSet(WidgetPointerMessage);
+
+////Intro pictures//////////////////////////
+	GrImageDraw(&sContext, g_pui8Image, 0, 0);
+	GrFlush(&sContext);
+	SysCtlDelay(ui32SysClkFreq);
+
+	GrImageDraw(&sContext, g_pui9Image, 0, 0);
+	GrFlush(&sContext);
 	SysCtlDelay(ui32SysClkFreq);
 	ClrScreen();
 ////////////////////////////////////////////
@@ -1640,14 +2542,37 @@ int main(void) {
 				PixelsCalculation(inputs2);
 		}
 
+		// when no trigger is found within the timeout in auto mode, provide one so the signal can be seen
+		if(TriggerSweep == 0 && TriggerStart == 0 && RollMode == 0 && TickMs - ArmedMs >= AutoTimeout)
+			ForceTrigger();
+
+		// in roll mode scroll the newest values onto the display at the frame rate
+		if(RollMode == 1 && TickMs - RollMs >= RollFrameMs)
+			RollDisplay();
+
+		// show a new reading of the frequency counter, also while the display is stopped. Edges that stop end the
+		// reading and start the counter over with one edge per interrupt
+		if(CounterReady == 1)
+			CounterUpdate();
+		else if(CounterOn == 1 && TickMs - CounterMs >= CounterTimeoutMs){
+			CounterSetup();
+			DrawCounter();
+		}
+
 				// Issue paint request to the widgets.
 
-				if(stop == 0){
+				// in roll mode the display only changes when it scrolls
+				if(stop == 0 && (RollMode == 0 || RollPaint == 1)){
+					RollPaint = 0;
 					WidgetPaint((tWidget *) &g_sWaveform);
 					WidgetPaint((tWidget * ) &g_psBotButtons[0]);
 					WidgetPaint((tWidget * ) &g_psBotButtons[1]);
 					WidgetPaint((tWidget * ) &g_psBotButtons[2]);
 					WidgetPaint((tWidget * ) &g_psBotButtons[3]);
+
+					// a single sweep stops once its frame has been drawn, a segmented sweep once a segment is shown
+					if((TriggerSweep == 2 && SingleArmed == 0) || (TriggerSweep == 3 && Frozen == 1))
+						stop = 1;
 				}
 
 				//
@@ -1660,333 +2585,558 @@ int main(void) {
 }
 
 void PixelsCalculation(uint32_t input[MEM_BUFFER_SIZE]) {
-	// determine which bits are high and low
-	for (f = 0; f < MEM_BUFFER_SIZE; f++) {
+	// comparator level of channel 2, which is the qualifier level when a pattern source is used
+	uint16_t Level2 = (TriggerSource == 2) ? *PTriggerLevel : QualifierLevel;
+	// both levels as a pair, a level above every value stays above it within the 12 bits PairAtLeast compares
+	uint32_t Levels = PairOf((*PTriggerLevel > 4096) ? 4096 : *PTriggerLevel, (Level2 > 4096) ? 4096 : Level2);
+	uint8_t Pattern, Edge, Level, Mid;
+
+	// buffers that arrive after a record was frozen must not overwrite it
+	if(Frozen == 1)
+		return;
+
+	// the statistics of every value are only gathered while a shown measurement needs them, from a clean start
+	if(MeasureNeeded() != MeasureOn){
+		MeasureOn = MeasureOn ^ 1;
+		MeasureReset();
+	}
 
-		receive[0] = (input[f] & 0b00000000000000000000000000000001)/0b00000000000000000000000000000001;
-		receive[1] = (input[f] & 0b00000000000000000000000000000010)/0b00000000000000000000000000000010;
-		receive[2] = (input[f] & 0b00000000000000000000000000000100)/0b00000000000000000000000000000100;
-		receive[3] = (input[f] & 0b00000000000000000000000000001000)/0b00000000000000000000000000001000;
-		receive[4] = (input[f] & 0b00000000000000000000000000010000)/0b00000000000000000000000000010000;
-		receive[5] = (input[f] & 0b00000000000000000000000000100000)/0b00000000000000000000000000100000;
-		receive[6] = (input[f] & 0b00000000000000000000000001000000)/0b00000000000000000000000001000000;
-		receive[7] = (input[f] & 0b00000000000000000000000010000000)/0b00000000000000000000000010000000;
-		receive[8] = (input[f] & 0b00000000000000000000000100000000)/0b00000000000000000000000100000000;
-		receive[9] = (input[f] & 0b00000000000000000000001000000000)/0b00000000000000000000001000000000;
-		receive[10] = (input[f] & 0b00000000000000000000100000000000)/0b00000000000000000000100000000000;
-		receive[11] = (input[f] & 0b00000000000000000001000000000000)/0b00000000000000000001000000000000;
-		receive[12] = (input[f] & 0b00000000000000000010000000000000)/0b00000000000000000010000000000000;
-		receive[13] = (input[f] & 0b00000000000000000100000000000000)/0b00000000000000000100000000000000;
-		receive[14] = (input[f] & 0b00000000000000001000000000000000)/0b00000000000000001000000000000000;
-		receive[15] = (input[f] & 0b00000000000000010000000000000000)/0b00000000000000010000000000000000;
-		receive[16] = (input[f] & 0b00000000000000100000000000000000)/0b00000000000000100000000000000000;
-		receive[17] = (input[f] & 0b00000000000001000000000000000000)/0b00000000000001000000000000000000;
-		receive[18] = (input[f] & 0b00000000000010000000000000000000)/0b00000000000010000000000000000000;
-		receive[19] = (input[f] & 0b00000001000000000000000000000000)/0b00000001000000000000000000000000;
-		receive[20] = (input[f] & 0b00000010000000000000000000000000)/0b00000010000000000000000000000000;
-		receive[21] = (input[f] & 0b00000100000000000000000000000000)/0b00000100000000000000000000000000;
-		receive[22] = (input[f] & 0b00001000000000000000000000000000)/0b00001000000000000000000000000000;
-		receive[23] = (input[f] & 0b00010000000000000000000000000000)/0b00010000000000000000000000000000;
-
-		// calculate decimal value if number is positive
-		if(receive[11] == 0){
-
-			totalA = 2048 + (receive[0] + 2*receive[1] + 4*receive[2] + 8*receive[3]
-			         + 16*receive[4] + 32*receive[5] + 64*receive[6] + 128*receive[7]
-			         + 1*(256*receive[8] + 512*receive[9] + 1024*receive[10]));
-
-			values[f + k*MEM_BUFFER_SIZE] = totalA & 0b00000000000000000000111111111111;
-		}
-		// calculate decimal value if number is negative
-		else{
+	// auto sweep at slow time scales scrolls the display instead of waiting for a trigger
+	RollMode = (TriggerSweep == 0 && Time >= ROLL_TIME);
+	if(RollMode == 1)
+		TriggerStart = 0;
 
-			// first negate all bits
-			if(receive[0])
-				receive[0] = 0;
-			else
-				receive[0] = 1;
+	for (f = 0; f < MEM_BUFFER_SIZE; f++) {
 
-			if(receive[1])
-				receive[1] = 0;
-			else
-				receive[1] = 1;
+		// convert both 12-bit two's complement values to offset binary. Channel 1 is on EPI bits 0-9 and 11-12,
+		// channel 2 is on EPI bits 13-19 and 24-28
+		Pair = ((input[f] & 0x3FF) | ((input[f] << 3) & 0x7F0000) | ((input[f] >> 1) & 0xF800C00)) ^ 0x8000800;
+		totalA = Pair & PAIR_LOW;
+		totalB = Pair >> 16;
+
+		// determine the comparator state of both channels and look up the trigger pattern from them, then start the
+		// trigger on a positive edge (TriggerMode 0) or negative edge (TriggerMode 1) of the pattern without branching.
+		// The trigger is only armed once enough values are in the ring to fill the display before the trigger position
+		Pattern = (TriggerPattern >> PairAtLeast(Pair, Levels)) & 1;
+		Edge = (Pattern ^ TriggerState) & (Pattern ^ TriggerMode) & Armed;
+		TriggerState = Pattern;
+
+		// remember where in the ring the trigger was found and where in between the two samples the level was crossed
+		if(Edge == 1 && TriggerStart == 0){
+			TriggerStart = 1;
+			TriggerSlot = RingIndex;
+			WindowPre = TriggerPosition;
+			PostSlots = 0;
+			TriggerFrac = ((SkipCount << 8) + TriggerFraction(PrevA, totalA, PrevB, totalB, Level2)) / (NumSkip + 1);
+			// a hi-res value is the average of its group, which lies half a group before the last value in it
+			if(CaptureMode == 4)
+				TriggerFrac = TriggerFrac + (NumSkip << 7) / (NumSkip + 1);
+			SetRecordLength();
+			if(TriggerSweep == 3)
+				SegmentStamp[Segment] = SampleStamp(input, f);
+		}
 
-			if(receive[2])
-				receive[2] = 0;
-			else
-				receive[2] = 1;
+		// add the values to the statistics of the current block and follow both channels through their hysteresis
+		// bands, a channel goes high above the top of its band and low at or below the bottom of it
+		if(MeasureOn == 1){
+			MeasureLow = PairMin(MeasureLow, Pair);
+			MeasureHigh = PairMax(MeasureHigh, Pair);
+			MeasureSum[0] = MeasureSum[0] + totalA;
+			MeasureSum[1] = MeasureSum[1] + totalB;
+			MeasureSquares[0] = MeasureSquares[0] + (uint32_t)totalA * totalA;
+			MeasureSquares[1] = MeasureSquares[1] + (uint32_t)totalB * totalB;
+			// the time of an edge is where the channel last rose through the middle of its band while below the band
+			Mid = PairAtLeast(Pair, MeasureMiddle);
+			if((Mid & ~MeasureMid & ~MeasureLevel) != 0)
+				MeasureCrossing(Mid & ~MeasureMid & ~MeasureLevel);
+			MeasureMid = Mid;
+			Level = (MeasureLevel | PairAtLeast(Pair, MeasureUpper)) & ~PairAtLeast(MeasureLower, Pair) & 3;
+			if((Level & ~MeasureLevel) != 0)
+				MeasureEdge(Level & ~MeasureLevel);
+			MeasureLevel = Level;
+			CycleLow = PairMin(CycleLow, Pair);
+			CycleHigh = PairMax(CycleHigh, Pair);
+			MeasureAbove[0] = MeasureAbove[0] + (Level & 1);
+			MeasureAbove[1] = MeasureAbove[1] + (Level >> 1);
+			MeasureSample++;
+		}
+		if(HistogramOn != 0)
+			HistogramCounts[(Pair >> HistogramShift) & (HistogramBins - 1)]++;
 
-			if(receive[3])
-				receive[3] = 0;
-			else
-				receive[3] = 1;
+		PrevA = totalA;
+		PrevB = totalB;
 
-			if(receive[4])
-				receive[4] = 0;
-			else
-				receive[4] = 1;
+		// in peak detect mode keep the lowest and highest values of the skipped group so no value is missed
+		if(CaptureMode == 3){
+			BucketLow = PairMin(BucketLow, Pair);
+			BucketHigh = PairMax(BucketHigh, Pair);
+		}
+		// in hi-res mode sum up the skipped group so its average can be stored
+		else if(CaptureMode == 4){
+			BucketSumA = BucketSumA + totalA;
+			BucketSumB = BucketSumB + totalB;
+		}
 
-			if(receive[5])
-				receive[5] = 0;
-			else
-				receive[5] = 1;
+		// wait until the desired number of values have been skipped, then store the value in the ring
+		if(SkipCount < NumSkip){
+			SkipCount++;
+		}
+		else{
+			SkipCount = 0;
+			if(CaptureMode == 3){
+				PairPut(values, RingIndex, BucketHigh);
+				PairPut(valuesLow, RingIndex, BucketLow);
+				BucketLow = PairOf(4095, 4095);
+				BucketHigh = 0;
+			}
+			// store the average of the group as a whole part and a fraction out of 4096
+			else if(CaptureMode == 4){
+				PairPut(values, RingIndex, PairOf(BucketSumA / (NumSkip + 1), BucketSumB / (NumSkip + 1)));
+				PairPut(valuesLow, RingIndex, PairOf(((BucketSumA % (NumSkip + 1)) << 12) / (NumSkip + 1),
+						((BucketSumB % (NumSkip + 1)) << 12) / (NumSkip + 1)));
+				BucketSumA = 0;
+				BucketSumB = 0;
+			}
+			else{
+				PairPut(values, RingIndex, Pair);
+			}
+			RingIndex++;
+			if(RingIndex == RecordSize)
+				RingIndex = 0;
+			if(ValidSlots < RecordSize)
+				ValidSlots++;
+			if(MeasureOn == 1){
+				MeasureSlots++;
+				if(MeasureSlots == MeasureBlockSlots)
+					CloseBlock();
+			}
+			Armed = (ValidSlots > TriggerPosition) & ((TriggerSweep != 2) | SingleArmed) & (RollMode ^ 1);
+			if(RollMode == 1 && RollSlots < SERIES_LENGTH)
+				RollSlots++;
+			// time from the last segment filling until the next one can trigger
+			if(ReArming == 1 && Armed == 1){
+				ReArming = 0;
+				if(SampleStamp(input, f) - SegmentEnd < ReArmMin)
+					ReArmMin = SampleStamp(input, f) - SegmentEnd;
+			}
 
-			if(receive[6])
-				receive[6] = 0;
-			else
-				receive[6] = 1;
+			if(TriggerStart == 1){
+				PostSlots++;
+				// build the frame once all values after the trigger position are in the ring
+				if(PostSlots == FramePost){
+					// a segmented sweep leaves the frame in the ring of its segment and draws nothing until all are filled
+					if(TriggerSweep == 3){
+						NextSegment(SampleStamp(input, f));
+						if(Frozen == 1)
+							return;
+					}
+					else if(CaptureWindow() == 1){
+						MeasureFrame(WindowPre + FramePost);
+						UpdateMeasurements();
+						// a single sweep is done once its frame is ready
+						if(TriggerSweep == 2){
+							SingleArmed = 0;
+							Armed = 0;
+						}
+					}
+				}
+				// restart the trigger once the whole record is in the ring, a finished single sweep keeps it
+				if(PostSlots >= RecordPost){
+					TriggerStart = 0;
+					ArmedMs = TickMs;
+					if(TriggerSweep == 2 && SingleArmed == 0){
+						FreezeRecord();
+						return;
+					}
+				}
+			}
+		}
+	}
+}
 
-			if(receive[7])
-				receive[7] = 0;
-			else
-				receive[7] = 1;
+// provide a trigger at the newest value in the ring, used by auto mode when no trigger was found in time. It waits
+// until the values before the trigger position are in the ring, which at slow time scales takes longer than the timeout
+void ForceTrigger(void){
+	if(ValidSlots <= TriggerPosition)
+		return;
+	TriggerStart = 1;
+	TriggerSlot = RingIndex;
+	WindowPre = TriggerPosition;
+	PostSlots = 0;
+	TriggerFrac = 256;
+	SetRecordLength();
+}
 
-			if(receive[8])
-				receive[8] = 0;
-			else
-				receive[8] = 1;
+// shift the displayed pixels left by the number of values stored since the last scroll and
+// add the new values from the ring on the right, so only the new values have to be looked up
+void RollDisplay(void){
+	uint16_t k = RollSlots;
+	uint32_t n, High, Low, Fraction;
+
+	if(k == 0)
+		return;
+	RollSlots = 0;
+	RollMs = TickMs;
+	RollPaint = 1;
+
+	for(i=0;i<SERIES_LENGTH-k;i++){
+		pixels[i] = pixels[i+k];
+		pixels2[i] = pixels2[i+k];
+		pixelsLow[i] = pixelsLow[i+k];
+		pixelsLow2[i] = pixelsLow2[i+k];
+		finepixels[i] = finepixels[i+k];
+		finepixels2[i] = finepixels2[i+k];
+	}
 
-			if(receive[9])
-				receive[9] = 0;
-			else
-				receive[9] = 1;
+	n = RingIndex + RecordSize - k;
+	if(n >= RecordSize)
+		n = n - RecordSize;
+	for(i=SERIES_LENGTH-k;i<SERIES_LENGTH;i++){
+		// the second ring holds the lowest values in peak detect mode and the fractions in hi-res mode
+		High = PairGet(values, n);
+		Fraction = PairGet(valuesLow, n);
+		Low = (CaptureMode == 3) ? Fraction : High;
+		pixels[i] = High & PAIR_LOW;
+		pixels2[i] = High >> 16;
+		pixelsLow[i] = Low & PAIR_LOW;
+		pixelsLow2[i] = Low >> 16;
+		finepixels[i] = (High << 16) | ((Fraction & PAIR_LOW) << 4);
+		finepixels2[i] = (High & ~PAIR_LOW) | ((Fraction >> 16) << 4);
+		n++;
+		if(n == RecordSize)
+			n = 0;
+	}
+	DrawBand = (CaptureMode == 3);
 
-			if(receive[10])
-				receive[10] = 0;
-			else
-				receive[10] = 1;
+	MeasureFrame(SERIES_LENGTH);
+	UpdateMeasurements();
+}
 
-			totalA = 2048 - (1 + receive[0] + 2*receive[1] + 4*receive[2] + 8*receive[3]
-			         + 16*receive[4] + 32*receive[5] + 64*receive[6] + 128*receive[7]
-			         + 1*(256*receive[8] + 512*receive[9] + 1024*receive[10]));
+// determine how many ring slots around the trigger make up the record. A single sweep keeps the whole ring
+// with the trigger at the same relative position as on the display, otherwise only the display is needed
+void SetRecordLength(void){
+	uint8_t Shift = 0;
+
+	// a crossing past the end of the trigger slot moves the trigger to the next slot, which has to be waited for
+	if(TriggerFrac > 256){
+		TriggerFrac = TriggerFrac - 256;
+		TriggerSlot++;
+		if(TriggerSlot == RecordSize)
+			TriggerSlot = 0;
+		Shift = 1;
+	}
+	FramePost = SERIES_LENGTH - WindowPre + (WindowPre == SERIES_LENGTH) + Shift;
+
+	if(TriggerSweep == 2){
+		RecordPre = RecordSize * WindowPre / SERIES_LENGTH;
+		if(RecordPre > ValidSlots)
+			RecordPre = ValidSlots;
+		if(RecordPre > RecordSize - SERIES_LENGTH - 1)
+			RecordPre = RecordSize - SERIES_LENGTH - 1;
+		RecordPost = RecordSize - RecordPre + Shift;
+	}
+	else{
+		RecordPre = WindowPre;
+		RecordPost = FramePost;
+	}
+}
 
-			values[f + k*MEM_BUFFER_SIZE] = totalA & 0b00000000000000000000111111111111;
+// halt DMA once a single sweep has its record and build the summaries used to view it
+void FreezeRecord(void){
+	uint32_t n, r;
+	// in peak detect mode the lowest values have their own ring
+	uint8_t *Low = (CaptureMode == 3) ? valuesLow : values;
+
+	Frozen = 1;
+	RecordStart = TriggerSlot + RecordSize - RecordPre;
+	if(RecordStart >= RecordSize)
+		RecordStart = RecordStart - RecordSize;
+
+	n = RecordStart;
+	for(r=0;r<RecordSize;r++){
+		if((r & ((1 << SUMMARY_SHIFT) - 1)) == 0){
+			summin[r >> SUMMARY_SHIFT] = PairOf(4095, 4095);
+			summax[r >> SUMMARY_SHIFT] = 0;
 		}
+		summin[r >> SUMMARY_SHIFT] = PairMin(summin[r >> SUMMARY_SHIFT], PairGet(Low, n));
+		summax[r >> SUMMARY_SHIFT] = PairMax(summax[r >> SUMMARY_SHIFT], PairGet(values, n));
+		n++;
+		if(n == RecordSize)
+			n = 0;
+	}
 
-		// calculate decimal value if number is positive
-		if(receive[23] == 0){
+	// start out showing the same part of the record as the captured frame, and draw it once more with the
+	// measurements of every cycle in the record
+	ViewZoom = 0;
+	ViewStart = RecordPre - WindowPre;
+	if(MeasureOn == 1)
+		RecordCycles();
+	stop = 0;
+}
 
-			totalB = 2048 + (receive[12] + 2*receive[13] + 4*receive[14] + 8*receive[15]
-			         + 16*receive[16] + 32*receive[17] + 64*receive[18] + 128*receive[19]
-			         + 1*(256*receive[20] + 512*receive[21] + 1024*receive[22]));
+// restart DMA after a frozen record, the values in the ring are no longer continuous with new ones
+void ResumeAcquisition(void){
+	if(Frozen == 0)
+		return;
 
-			values2[f + k*MEM_BUFFER_SIZE] = totalB & 0b00000000000000000000111111111111;
-		}
-		// calculate decimal value if number is negative
-		else{
+	Frozen = 0;
+	DrawBand = (CaptureMode == 3 || CaptureMode == 5);
+	ArmTrigger();
+	transfer_done[0] = 0;
+	transfer_done[1] = 0;
+	SetupDMA();
+	EPINonBlockingReadConfigure(EPI0_BASE, 0, EPI_NBCONFIG_SIZE_32, 0);
+	EPINonBlockingReadStart(EPI0_BASE, 0, CountSize);
 
-			// first negate all bits
-			if(receive[12])
-				receive[12] = 0;
-			else
-				receive[12] = 1;
-
-			if(receive[13])
-				receive[13] = 0;
-			else
-				receive[13] = 1;
-
-			if(receive[14])
-				receive[14] = 0;
-			else
-				receive[14] = 1;
-
-			if(receive[15])
-				receive[15] = 0;
-			else
-				receive[15] = 1;
-
-			if(receive[16])
-				receive[16] = 0;
-			else
-				receive[16] = 1;
-
-			if(receive[17])
-				receive[17] = 0;
-			else
-				receive[17] = 1;
-
-			if(receive[18])
-				receive[18] = 0;
-			else
-				receive[18] = 1;
-
-			if(receive[19])
-				receive[19] = 0;
-			else
-				receive[19] = 1;
-
-			if(receive[20])
-				receive[20] = 0;
-			else
-				receive[20] = 1;
-
-			if(receive[21])
-				receive[21] = 0;
-			else
-				receive[21] = 1;
-
-			if(receive[22])
-				receive[22] = 0;
-			else
-				receive[22] = 1;
-
-			totalB = 2048 - (1 + receive[12] + 2*receive[13] + 4*receive[14] + 8*receive[15]
-			         + 16*receive[16] + 32*receive[17] + 64*receive[18] + 128*receive[19]
-			         + 1*(256*receive[20] + 512*receive[21] + 1024*receive[22]));
-
-			values2[f + k*MEM_BUFFER_SIZE] = totalB & 0b00000000000000000000111111111111;
-		}
-
-
-		// determine which trigger mode and source is being used and then start the trigger if the values increment (positive edge)
-		// or decrement (negative edge) over the desired trigger level
-		if(TriggerMode == 0){
-			if(TriggerSource == 1){
-				if(values[f + k*MEM_BUFFER_SIZE-1] <= *PTriggerLevel && values[f + k*MEM_BUFFER_SIZE] >= *PTriggerLevel){
-					TriggerStart = 1;
-					Trigger = 1;
-				}
+	CanvasTextSet(&g_sAddMinusTime, timVolDivC1);
+	PushButtonTextSet(&g_psTopButtons[2], timVolDivC1);
+	WidgetPaint((tWidget * ) &g_psTopButtons[2]);
+}
+
+// draw the part of a frozen record starting at ViewStart with 1 << ViewZoom ring slots per pixel. Each pixel
+// shows the minimum and maximum of its slots, taken from the summaries when a pixel covers whole groups
+void RenderRecord(void){
+	uint32_t Step = 1 << ViewZoom, n, r, LowPair, HighPair, Value;
+	uint8_t *Low = (CaptureMode == 3) ? valuesLow : values;
+
+	for(i=0;i<SERIES_LENGTH;i++){
+		LowPair = PairOf(4095, 4095);
+		HighPair = 0;
+		if(Step >= (1 << SUMMARY_SHIFT)){
+			for(r = (ViewStart + i*Step) >> SUMMARY_SHIFT; r < (ViewStart + (i+1)*Step) >> SUMMARY_SHIFT; r++){
+				LowPair = PairMin(LowPair, summin[r]);
+				HighPair = PairMax(HighPair, summax[r]);
 			}
-			else
-				if(values2[f + k*MEM_BUFFER_SIZE-1] <= *PTriggerLevel && values2[f + k*MEM_BUFFER_SIZE] >= *PTriggerLevel){
-					TriggerStart = 1;
-					Trigger = 1;
-				}
 		}
-		else if(TriggerMode == 1){
-			if(TriggerSource == 1){
-				if(values[f + k*MEM_BUFFER_SIZE-1] >= *PTriggerLevel && values[f + k*MEM_BUFFER_SIZE] <= *PTriggerLevel){
-					TriggerStart = 1;
-					Trigger = 1;
-				}
+		else{
+			n = RecordStart + ViewStart + i*Step;
+			if(n >= RecordSize)
+				n = n - RecordSize;
+			for(r=0;r<Step;r++){
+				Value = PairGet(values, n);
+				HighPair = PairMax(HighPair, Value);
+				if(Low != values)
+					Value = PairGet(Low, n);
+				LowPair = PairMin(LowPair, Value);
+				n++;
+				if(n == RecordSize)
+					n = 0;
 			}
-			else
-				if(values2[f + k*MEM_BUFFER_SIZE] >= *PTriggerLevel && values2[f + k*MEM_BUFFER_SIZE] <= *PTriggerLevel){
-					TriggerStart = 1;
-					Trigger = 1;
-				}
 		}
+		pixels[i] = HighPair & PAIR_LOW;
+		pixelsLow[i] = LowPair & PAIR_LOW;
+		pixels2[i] = HighPair >> 16;
+		pixelsLow2[i] = LowPair >> 16;
+	}
+	DrawBand = (Step > 1 || CaptureMode == 3 || CaptureMode == 5);
 
-		// Start finding pixel values when trigger found
-		if(TriggerStart == 1){
-			// for normal acquire mode
-			if(CaptureMode == 0){
-				if(begin == 0){
-					begin=1;
-					// find all pixel values before trigger position
-					for(i=0;i<TriggerPosition;i++){
-						if((int32_t) (f + k*MEM_BUFFER_SIZE - TriggerPosition + i*(NumSkip+1)) < 0){
-							pixels[i] = values[MaxSize - (f + k*MEM_BUFFER_SIZE - TriggerPosition + i*(NumSkip+1))];
-							pixels2[i] = values2[MaxSize - (f + k*MEM_BUFFER_SIZE - TriggerPosition + i*(NumSkip+1))];
-						}
-						else{
-							pixels[i] = values[f + k*MEM_BUFFER_SIZE - TriggerPosition + i*(NumSkip+1)];
-							pixels2[i] = values2[f + k*MEM_BUFFER_SIZE - TriggerPosition + i*(NumSkip+1)];
-						}
-					}
-				}
-				// wait until the desired number of values have been skipped
-				if(j<NumSkip){
-					j++;
-				}
-				else{
-					j=0;
-					// set all pixel values to the values obtained from the ADC
-					if(m < SERIES_LENGTH){
-						pixels[m] = values[f + k*MEM_BUFFER_SIZE];
-						pixels2[m] = values2[f + k*MEM_BUFFER_SIZE];
-						m++;
-					}
-					// update measurements and restart trigger if all pixel values have been found
-					else{
-						UpdateMeasurements();
-						m = 0;
-						begin = 0;
-						TriggerStart = 0;
-					}
-				}
+	// let the main loop draw the view once, a single sweep stops again after it
+	stop = 0;
+}
+
+// zoom out of (Direction 1) or into (Direction -1) a frozen record around the center of the view
+void ZoomRecord(int8_t Direction){
+	uint32_t Center = ViewStart + (SERIES_LENGTH << ViewZoom) / 2;
+
+	// the most zoomed out view fits the whole record on the display
+	if(Direction > 0 && (SERIES_LENGTH << (ViewZoom + 1)) <= RecordSize)
+		ViewZoom++;
+	else if(Direction < 0 && ViewZoom > 0)
+		ViewZoom--;
+
+	if(Center < (SERIES_LENGTH << ViewZoom) / 2)
+		ViewStart = 0;
+	else
+		ViewStart = Center - (SERIES_LENGTH << ViewZoom) / 2;
+	if(ViewStart > RecordSize - (SERIES_LENGTH << ViewZoom))
+		ViewStart = RecordSize - (SERIES_LENGTH << ViewZoom);
+
+	usprintf(ZoomDisplay, " 1:%d", 1 << ViewZoom);
+	CanvasTextSet(&g_sAddMinusTime, ZoomDisplay);
+	PushButtonTextSet(&g_psTopButtons[2], ZoomDisplay);
+	WidgetPaint((tWidget * ) &g_psTopButtons[2]);
+	WidgetPaint((tWidget * ) &g_sAddMinusTime);
+
+	RenderRecord();
+}
+
+// screen row of a value, kept inside the waveform area
+int16_t PixelRow(uint16_t Value, uint16_t Mid, float Divider){
+	int16_t Row = Mid - Value / Divider;
+
+	if(Row < 29)
+		return 29;
+	if(Row > 210)
+		return 210;
+	return Row;
+}
+
+// build the displayed frame from the values in the ring around the trigger, returns 1 when a new frame is ready
+uint8_t CaptureWindow(void){
+	// ring slot of the first pixel, the pixel at the trigger position lines up with the trigger slot
+	uint32_t n = TriggerSlot + RecordSize - WindowPre;
+	uint32_t Value;
+
+	if(n >= RecordSize)
+		n = n - RecordSize;
+
+	for(i=0;i<SERIES_LENGTH;i++){
+		// for normal acquire mode
+		if(CaptureMode == 0){
+			Value = InterpolatePair(values, n, TriggerFrac);
+			pixels[i] = Value & PAIR_LOW;
+			pixels2[i] = Value >> 16;
+		}
+		// for peak detect mode each pixel is drawn from the lowest to the highest value of its group,
+		// which are not interpolated so that a glitch keeps its full height
+		else if(CaptureMode == 3){
+			Value = PairGet(values, n);
+			pixels[i] = Value & PAIR_LOW;
+			pixels2[i] = Value >> 16;
+			Value = PairGet(valuesLow, n);
+			pixelsLow[i] = Value & PAIR_LOW;
+			pixelsLow2[i] = Value >> 16;
+		}
+		// for envelope mode widen the band of each pixel to include the new value,
+		// the first frame after arming or starting over sets the band
+		else if(CaptureMode == 5){
+			Value = InterpolatePair(values, n, TriggerFrac);
+			if(j == 0){
+				envlow[i] = Value;
+				envhigh[i] = Value;
 			}
-			// for averaging mode
-			else if(CaptureMode == 1){
-				if(begin == 0){
-					begin=1;
-					if(j<NumAvg){
-						// find all pixel values before trigger position
-						for(i=0;i<TriggerPosition;i++){
-							if((int32_t) (f + k*MEM_BUFFER_SIZE - TriggerPosition) < 0){
-								totalsA[i] = totalsA[i] + values[MaxSize - (f + k*MEM_BUFFER_SIZE - TriggerPosition + i)];
-								totalsB[i] = totalsB[i] + values2[MaxSize - (f + k*MEM_BUFFER_SIZE - TriggerPosition + i)];
-							}
-							else{
-								totalsA[i] = totalsA[i] + values[f + k*MEM_BUFFER_SIZE - TriggerPosition + i];
-								totalsB[i] = totalsB[i] + values2[f + k*MEM_BUFFER_SIZE - TriggerPosition + i];
-							}
-						}
-					}
-				}
-				// keep summing up each pixel value until the number of sets have been gone through
-				if(j<NumAvg){
-					if(m < SERIES_LENGTH){
-						totalsA[m] = totalsA[m]+ values[f + k*MEM_BUFFER_SIZE];
-						totalsB[m] = totalsB[m]+ values2[f + k*MEM_BUFFER_SIZE];
-						m++;
-					}
-					else{
-						j++;
-						m=0;
-						begin = 0;
-						TriggerStart = 0;
-					}
-				}
-				// determine averaged pixel values and then reset trigger and sums
-				else{
-					j = 0;
-					for(i=0;i<TriggerPosition;i++){
-						totalsA[i] = totalsA[i]/2;
-						totalsB[i] = totalsB[i]/2;
-					}
-					for(i=0;i<SERIES_LENGTH;i++){
-						pixels[i] = totalsA[i]/NumAvg;
-						pixels2[i] = totalsB[i]/NumAvg;
-					}
-					for(i=0;i<SERIES_LENGTH;i++){
-						totalsA[i] = 0;
-						totalsB[i] = 0;
-					}
-					UpdateMeasurements();
-					m = 0;
-					begin = 0;
-					TriggerStart = 0;
-				}
+			else{
+				envlow[i] = PairMin(envlow[i], Value);
+				envhigh[i] = PairMax(envhigh[i], Value);
 			}
+			pixels[i] = envhigh[i] & PAIR_LOW;
+			pixelsLow[i] = envlow[i] & PAIR_LOW;
+			pixels2[i] = envhigh[i] >> 16;
+			pixelsLow2[i] = envlow[i] >> 16;
+		}
+		// for hi-res mode keep the extra bits of the averaged values for the measurements
+		else if(CaptureMode == 4){
+			InterpolateFine(values, valuesLow, n, TriggerFrac, &finepixels[i], &finepixels2[i]);
+			pixels[i] = (finepixels[i] + 32768) >> 16;
+			pixels2[i] = (finepixels2[i] + 32768) >> 16;
 		}
+		// for averaging mode keep summing up each pixel value
+		else if(CaptureMode == 1){
+			totals[i] = PairAdd(totals[i], InterpolatePair(values, n, TriggerFrac));
+		}
+		// for exponential average mode move the running average 1/2^ExpShift of the way to the new value,
+		// the first frame after arming starts the running average
+		else{
+			Value = InterpolatePair(values, n, TriggerFrac);
+			if(j == 0){
+				totalsA[i] = (Value & PAIR_LOW) << 8;
+				totalsB[i] = (Value >> 16) << 8;
+			}
+			else{
+				totalsA[i] = totalsA[i] + (((int32_t)((Value & PAIR_LOW) << 8) - (int32_t)totalsA[i]) >> ExpShift);
+				totalsB[i] = totalsB[i] + (((int32_t)((Value >> 16) << 8) - (int32_t)totalsB[i]) >> ExpShift);
+			}
+			pixels[i] = (totalsA[i] + 128) >> 8;
+			pixels2[i] = (totalsB[i] + 128) >> 8;
+		}
+		n++;
+		if(n == RecordSize)
+			n = 0;
 	}
-	if(Trigger == 1){
-		GoThrough = 0;
-		Trigger = 0;
+
+	DrawBand = (CaptureMode == 3 || CaptureMode == 5);
+	if(CaptureMode == 0 || CaptureMode == 3 || CaptureMode == 4)
+		return 1;
+
+	// a new envelope is ready on every trigger
+	if(CaptureMode == 5){
+		j++;
+		if(EnvelopeLimit != 0 && j >= EnvelopeLimit)
+			j = 0;
+		return 1;
 	}
-	// increment Gothrough if a trigger wasn't found in this iteration
-	else
-		GoThrough++;
 
-	if(GoThrough > 200){
-		GoThrough = 20;
+	// a new exponential average is ready on every trigger
+	if(CaptureMode == 2){
+		j = 1;
+		return 1;
 	}
 
-	// when enough iterations have passed, provide a trigger so the signal can be seen
-	if(GoThrough >= 10){
-		TriggerStart = 1;
-		UpdateMeasurements();
+	// determine averaged pixel values and reset the sums once the number of sets have been gone through
+	j++;
+	if(j < NumAvg)
+		return 0;
+	j = 0;
+	for(i=0;i<SERIES_LENGTH;i++){
+		pixels[i] = (totals[i] & PAIR_LOW)/NumAvg;
+		pixels2[i] = (totals[i] >> 16)/NumAvg;
+		totals[i] = 0;
 	}
+	return 1;
+}
 
+// restart the trigger and forget the values in the ring, used when the ring no longer matches the time scale
+void ArmTrigger(void){
+	TriggerStart = 0;
+	ArmedMs = TickMs;
+	TriggerState = 0;
+	SkipCount = 0;
+	BucketLow = PairOf(4095, 4095);
+	BucketHigh = 0;
+	BucketSumA = 0;
+	BucketSumB = 0;
+	ValidSlots = 0;
+	Armed = 0;
+	j = 0;
+	MeasureReset();
+	for(i=0;i<SERIES_LENGTH;i++){
+		totals[i] = 0;
+		totalsA[i] = 0;
+		totalsB[i] = 0;
+	}
+}
 
-// keep going further in the values array as long as the Maximum Size won't be reached in the next iteration
-if(k*MEM_BUFFER_SIZE + MEM_BUFFER_SIZE < MaxSize)
-	k++;
+// find the fraction (out of 256) of a sample period after the previous sample at which the trigger level was
+// crossed by linearly interpolating the two samples that straddle the level. The trigger source picks the channel,
+// a pattern edge is timed on channel 1 unless only the qualifier on channel 2 changed
+uint16_t TriggerFraction(uint16_t PrevA, uint16_t A, uint16_t PrevB, uint16_t B, uint16_t Level2){
+	uint16_t before = PrevA, after = A, level = *PTriggerLevel;
 
-else
-	k = 0;
+	if(TriggerSource == 2 || (TriggerSource >= 3 && (PrevA >= level) == (A >= level))){
+		before = PrevB;
+		after = B;
+		level = Level2;
+	}
+
+	if(after == before)
+		return 256;
+	return (((int32_t) level - before) << 8) / ((int32_t) after - before);
+}
+
+// linearly interpolate both channels between slot n-1 and slot n of the ring, frac being out of 256
+uint32_t InterpolatePair(uint8_t *ring, uint32_t n, uint16_t frac){
+	uint32_t before = PairGet(ring, (n == 0) ? RecordSize - 1 : n - 1), after = PairGet(ring, n);
+	uint16_t A = (before & PAIR_LOW) + ((((int32_t)(after & PAIR_LOW) - (int32_t)(before & PAIR_LOW)) * frac) >> 8);
+	uint16_t B = (before >> 16) + ((((int32_t)(after >> 16) - (int32_t)(before >> 16)) * frac) >> 8);
+
+	return PairOf(A, B);
+}
+
+// same as InterpolatePair for hi-res values made of a whole part and a fraction, the results are times 65536
+void InterpolateFine(uint8_t *ring, uint8_t *fraction, uint32_t n, uint16_t frac, uint32_t *Fine1, uint32_t *Fine2){
+	uint32_t m = (n == 0) ? RecordSize - 1 : n - 1;
+	uint32_t Whole = PairGet(ring, m), Fraction = PairGet(fraction, m);
+	uint32_t before1 = (Whole << 16) | ((Fraction & PAIR_LOW) << 4);
+	uint32_t before2 = (Whole & ~PAIR_LOW) | ((Fraction >> 16) << 4);
+	uint32_t after1, after2;
+
+	Whole = PairGet(ring, n);
+	Fraction = PairGet(fraction, n);
+	after1 = (Whole << 16) | ((Fraction & PAIR_LOW) << 4);
+	after2 = (Whole & ~PAIR_LOW) | ((Fraction >> 16) << 4);
+
+	*Fine1 = before1 + ((((int32_t)after1 - (int32_t)before1) >> 8) * frac);
+	*Fine2 = before2 + ((((int32_t)after2 - (int32_t)before2) >> 8) * frac);
 }
 
 void ClrScreen() {
@@ -2006,8 +3156,14 @@ void ClrMyWidget(){
 //	WidgetRemove((tWidget *) &g_sContainerMath);
 	WidgetRemove((tWidget *) &g_sContainerTriggerSource);
 	WidgetRemove((tWidget *) &g_sContainerTriggerMode);
+	WidgetRemove((tWidget *) &g_sContainerTriggerSweep);
 	WidgetRemove((tWidget *) &g_sTriggerSliderVertical);
 	WidgetRemove((tWidget *) &g_sTriggerSliderHorizontal);
+	WidgetRemove((tWidget *) &g_sCursorSliderTime1);
+	WidgetRemove((tWidget *) &g_sCursorSliderTime2);
+	WidgetRemove((tWidget *) &g_sCursorSliderLevel1);
+	WidgetRemove((tWidget *) &g_sCursorSliderLevel2);
+	WidgetRemove((tWidget *) &g_sQualifierSlider);
 	WidgetRemove((tWidget *) &g_sContainerTriggers);
 	WidgetRemove((tWidget *) &g_sContainerAcquire);
 	WidgetRemove((tWidget *) &g_sContainerFreMagnitudeC1);
@@ -2023,6 +3179,60 @@ void ClrMyWidget(){
 	WidgetPaint((tWidget * )&g_sWaveform);
 }
 
+////////////////////////////////////////////////////////
+// Timer 0 interrupt function, counts milliseconds
+////////////////////////////////////////////////////////
+void Timer0IntHandler(void) {
+	TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+	TickMs++;
+}
+
+////////////////////////////////////////////////////////
+// Timer 3 interrupt function, time stamps every CounterEdges edges of the frequency counter
+////////////////////////////////////////////////////////
+void Timer3IntHandler(void) {
+	uint32_t Stamp = TimerValueGet(TIMER1_BASE, TIMER_A), Counted = CounterEdges;
+
+	// edges that come faster than this handler runs would keep the CPU here until the main loop sets the edges
+	// from a reading, so interrupts that follow each other closely take 16 times the edges right away
+	if(Stamp - CounterLast < CounterBurst && CounterNext < CounterMaxEdges / 16 && CounterNext == CounterEdges)
+		CounterNext = CounterEdges * 16;
+	CounterLast = Stamp;
+	CounterMs = TickMs;
+
+	// Timer 3 stops once it has counted its edges, start it again right away so few edges are missed
+	TimerIntClear(TIMER3_BASE, TIMER_CAPA_MATCH);
+	if(CounterNext != CounterEdges){
+		CounterEdges = CounterNext;
+		TimerPrescaleSet(TIMER3_BASE, TIMER_A, CounterEdges >> 16);
+		TimerLoadSet(TIMER3_BASE, TIMER_A, CounterEdges & 0xFFFF);
+	}
+	TimerEnable(TIMER3_BASE, TIMER_A);
+
+	if(CounterStarted == 1){
+		CounterCount = CounterCount + Counted;
+		// the gate is over at the first stamped edge after the gate time, which also starts the next gate
+		if(Stamp - CounterStart >= CounterGateMs * (ui32SysClkFreq / 1000)){
+			CounterPeriods = CounterCount;
+			CounterTime = Stamp - CounterStart;
+			CounterDeadTime = CounterDead;
+			CounterParts = CounterWindows;
+			CounterReady = 1;
+			CounterStarted = 0;
+		}
+	}
+	if(CounterStarted == 0){
+		CounterStarted = 1;
+		CounterStart = Stamp;
+		CounterCount = 0;
+		CounterDead = 0;
+		CounterWindows = 0;
+	}
+	CounterWindows++;
+	// edges from the stamped edge until Timer 3 counts again are missed
+	CounterDead = CounterDead + TimerValueGet(TIMER1_BASE, TIMER_A) - Stamp + CounterLatency;
+}
+
 ////////////////////////////////////////////////////////
 // EPI interrupt fuction
 //////////////////////////////////////////////////
@@ -2032,7 +3242,8 @@ void EPIIntHandler(void) {
 	EPIMode = EPIIntStatus(EPI0_BASE, true);
 	uDMAIntClear(UDMA_CHANNEL_SW);
 	EPIIntErrorClear(EPI0_BASE, EPI_INT_ERR_DMARDIC);
-	if (EPIMode == EPI_INT_DMA_RX_DONE) {
+	// leave the transfers stopped while a record is frozen
+	if (EPIMode == EPI_INT_DMA_RX_DONE && Frozen == 0) {
 
 		// determine if primary or alternate transfer is complete
 		pri = pui8ControlTable[488] & 0b11;
@@ -2040,6 +3251,7 @@ void EPIIntHandler(void) {
 
 		if (pri == 0) {
 			// reset primary transfer
+			BufferStamp[0] = TimerValueGet(TIMER1_BASE, TIMER_A);
 			transfer_done[0] = 1;
 			uDMAChannelTransferSet(UDMA_CHANNEL_SW | UDMA_PRI_SELECT,
 			UDMA_MODE_PINGPONG, EPISource, g_ui32DstBuf[0],
@@ -2053,6 +3265,7 @@ void EPIIntHandler(void) {
 
 		if (alt == 0) {
 			// reset alternate transfer
+			BufferStamp[1] = TimerValueGet(TIMER1_BASE, TIMER_A);
 			transfer_done[1] = 1;
 			uDMAChannelTransferSet(UDMA_CHANNEL_SW | UDMA_ALT_SELECT,
 			UDMA_MODE_PINGPONG, EPISource, g_ui32DstBuf2[0],
@@ -2116,6 +3329,8 @@ void SetupDMA(void) {
 // Main program//////////////////////////////////////////////////////////////////////////////
 void setup(void) {
 
+	SetupRings();
+
 	// point the destination buffer to the correct input arrays
 	for (f = 0; f < MEM_BUFFER_SIZE; f++) {
 		g_ui32DstBuf[f] = &inputs[f];
@@ -2136,6 +3351,9 @@ void setup(void) {
 	for(i=0;i<SERIES_LENGTH;i++){
 		totalsB[i] = 0;
 	}
+	for(i=0;i<SERIES_LENGTH;i++){
+		totals[i] = 0;
+	}
 	for(i=0;i<SERIES_LENGTH;i++){
 		old1[i] = 120;
 	}
@@ -2169,8 +3387,8 @@ void setup(void) {
 	secpixel[9] = (8*.00002)/240;
 	secpixel[10] = (8*.00005)/240;
 	secpixel[11] = (8*.0001)/240;
-	secpixel[12] = (8*.0005)/240;
-	secpixel[13] = (8*.0002)/240;
+	secpixel[12] = (8*.0002)/240;
+	secpixel[13] = (8*.0005)/240;
 	secpixel[14] = (8*.001)/240;
 	secpixel[15] = (8*.002)/240;
 	secpixel[16] = (8*.005)/240;
@@ -2225,6 +3443,35 @@ void setup(void) {
 	// Enable GPIO and Timer peripherals
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
 
+	// Timer 0 interrupts every millisecond to keep the time used by the auto trigger
+	TimerConfigure(TIMER0_BASE, TIMER_CFG_PERIODIC);
+	TimerLoadSet(TIMER0_BASE, TIMER_A, ui32SysClkFreq/1000 - 1);
+	TimerIntEnable(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+	IntEnable(INT_TIMER0A);
+	TimerEnable(TIMER0_BASE, TIMER_A);
+
+	// Timer 1 counts up at the system clock to time stamp the DMA buffers for segmented sweeps
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
+	TimerConfigure(TIMER1_BASE, TIMER_CFG_PERIODIC_UP);
+	TimerLoadSet(TIMER1_BASE, TIMER_A, 0xFFFFFFFF);
+	TimerEnable(TIMER1_BASE, TIMER_A);
+
+	// Timer 3 counts down rising edges on PD4 for the frequency counter and interrupts when it reaches 0. It
+	// preempts the EPI and millisecond interrupts so the time stamps are taken a fixed time after the edge
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER3);
+	GPIOPinConfigure(GPIO_PD4_T3CCP0);
+	GPIOPinTypeTimer(GPIO_PORTD_BASE, GPIO_PIN_4);
+	TimerConfigure(TIMER3_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_A_CAP_COUNT);
+	TimerControlEvent(TIMER3_BASE, TIMER_A, TIMER_EVENT_POS_EDGE);
+	TimerMatchSet(TIMER3_BASE, TIMER_A, 0);
+	TimerPrescaleMatchSet(TIMER3_BASE, TIMER_A, 0);
+	TimerIntEnable(TIMER3_BASE, TIMER_CAPA_MATCH);
+	IntPrioritySet(INT_TIMER3A, 0x00);
+	IntPrioritySet(INT_EPI0, 0x20);
+	IntPrioritySet(INT_TIMER0A, 0x20);
+	IntEnable(INT_TIMER3A);
+	CounterSetup();
+
 	// Enable EPI Peripheral
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_EPI0);
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
@@ -2775,145 +4022,948 @@ void SetupTrigger(uint16_t Level, uint8_t Start_Position, uint8_t Mode, uint8_t
 	TriggerMode = Mode; // 0 - positive edge, 1 - negative edge
 	TriggerSource = Source;
 	TriggerPosition = Start_Position;
-	Trigger = 0;
 	TriggerStart = 0;
-	GoThrough = 0;
+	TriggerState = 0;
+	ArmedMs = TickMs;
 }
 
 
-// function to update the voltage and frequency measurements
-void UpdateMeasurements(void){
-	// give inital values to all variables
-	Amp1[1] = 0;
-	Amp1[0] = 4097;
-	Amp2[1] = 0;
-	Amp2[0] = 4097;
-	freqref1 = pixels[3];
-	freqstart1 = 0;
-	freqref2 = pixels2[3];
-	freqstart2 = 0;
-	for(i=0;i<TimeAvg;i++){
-		t1[i] = 0;
-		t2[i] = 0;
-	}
-	l1 = 0;
-	l2 = 0;
-	for(i=0;i<SERIES_LENGTH;i++){
-		// determine if a min or max has been found
-		if(pixels[i] < Amp1[0]){
-			Amp1[0] = pixels[i];
-		}
-		if(pixels[i] > Amp1[1]){
-			Amp1[1] = pixels[i];
-		}
-		if(pixels2[i] < Amp2[0]){
-			Amp2[0] = pixels2[i];
-		}
-		if(pixels2[i] > Amp2[1]){
-			Amp2[1] = pixels2[i];
+// add a rising edge of the channels with bits set in Rising to the current block, which ends their cycles
+void MeasureEdge(uint8_t Rising){
+	uint8_t c;
+	uint32_t Period, Width, Amplitude, n;
+	int32_t Step, Delay;
+
+	for(c=0;c<2;c++){
+		if(((Rising >> c) & 1) == 0)
+			continue;
+		if(BlockEdges[MeasureBlock][c] == 0){
+			BlockFirstEdge[MeasureBlock][c] = MeasureCross[c];
+			BlockFirstAbove[MeasureBlock][c] = MeasureAbove[c];
 		}
-		// determine amount of delta time instances occur between positive triggered events
-		if(TriggerMode == 0 && i > 0){
-			if(pixels[i-1] <= freqref1 && pixels[i] >= freqref1 && freqstart1 == 0){
-				freqstart1 = 1;
-			}
-			else if(pixels[i-1] <= freqref1 && pixels[i] >= freqref1 && freqstart1 == 1){
-				freqstart1 = 0;
-				if(l1 < TimeAvg){
-					l1++;
-				}
+		BlockLastEdge[MeasureBlock][c] = MeasureCross[c];
+		BlockLastAbove[MeasureBlock][c] = MeasureAbove[c];
+		BlockEdges[MeasureBlock][c]++;
+
+		// the cycle that ends at this edge
+		if(((CycleStarted >> c) & 1) == 1){
+			Period = MeasureCross[c] - CycleCross[c];
+			n = CycleCount[c] & (CycleRing - 1);
+			CyclePeriod[c][n] = Period;
+			Width = MeasureAbove[c] - CycleAbove[c];
+			Amplitude = ((CycleHigh >> (c * 16)) & PAIR_LOW) - ((CycleLow >> (c * 16)) & PAIR_LOW);
+			CycleWidth[c][n] = Width;
+			CycleAmplitude[c][n] = Amplitude;
+			CycleCount[c]++;
+			BlockCycles[MeasureBlock][c]++;
+			BlockPeriods[MeasureBlock][c] = BlockPeriods[MeasureBlock][c] + Period;
+			BlockPeriodSquares[MeasureBlock][c] = BlockPeriodSquares[MeasureBlock][c] + (uint64_t)Period * Period;
+			BlockWidths[MeasureBlock][c] = BlockWidths[MeasureBlock][c] + Width;
+			BlockWidthSquares[MeasureBlock][c] = BlockWidthSquares[MeasureBlock][c] + (uint64_t)Width * Width;
+			BlockAmplitudes[MeasureBlock][c] = BlockAmplitudes[MeasureBlock][c] + Amplitude;
+			BlockAmplitudeSquares[MeasureBlock][c] = BlockAmplitudeSquares[MeasureBlock][c] + Amplitude * Amplitude;
+			if(CycleLast[c] != 0){
+				Step = (int32_t)(Period - CycleLast[c]);
+				BlockSteps[MeasureBlock][c]++;
+				BlockStepSquares[MeasureBlock][c] = BlockStepSquares[MeasureBlock][c] + (int64_t)Step * Step;
 			}
-			if(freqstart1 == 1){
-				t1[l1] = t1[l1] + 1;
+			CycleLast[c] = Period;
+		}
+		// the delay from the last edge of channel 1, which can be just after the crossing of channel 2 when both
+		// edges end in the same value, as long as channel 1 has not stopped for over a period
+		if(c == 1 && CycleLast[0] != 0){
+			Delay = (int32_t)(MeasureCross[1] - MeasureCross[0]);
+			if(Delay > (int32_t)(CycleLast[0] / 2))
+				Delay = Delay - (int32_t)CycleLast[0];
+			if(Delay <= (int32_t)(CycleLast[0] / 2)){
+				BlockDelays[MeasureBlock]++;
+				BlockDelaySum[MeasureBlock] = BlockDelaySum[MeasureBlock] + Delay;
 			}
+		}
+		CycleStarted = CycleStarted | (1 << c);
+		CycleCross[c] = MeasureCross[c];
+		CycleAbove[c] = MeasureAbove[c];
+		CycleLow = (CycleLow & ~((uint32_t)PAIR_LOW << (c * 16))) | ((uint32_t)4095 << (c * 16));
+		CycleHigh = CycleHigh & ~((uint32_t)PAIR_LOW << (c * 16));
+	}
+}
+
+// keep the time at which the channels with bits set in Rising crossed the middle of their bands, interpolated
+// between the previous and the current value. Times wrap around after 2^24 values, far more than a frame holds
+void MeasureCrossing(uint8_t Rising){
+	uint8_t c;
+	int32_t Before, After, Middle, Fraction;
+
+	for(c=0;c<2;c++){
+		if(((Rising >> c) & 1) == 0)
+			continue;
+		Before = (c == 0) ? PrevA : PrevB;
+		After = (c == 0) ? totalA : totalB;
+		Middle = (MeasureMiddle >> (c * 16)) & PAIR_LOW;
+		// a middle that moved since the previous value can leave it at or above the middle
+		Fraction = (Before >= Middle) ? 0 : ((Middle - Before) << 8) / (After - Before);
+		MeasureCross[c] = (MeasureSample << 8) - 256 + Fraction;
+	}
+}
 
-			if(pixels2[i-1] <= freqref2 && pixels2[i] >= freqref2 && freqstart2 == 0 && freqstop2 == 0){
-				freqstart2 = 1;
+// keep the statistics of the current block with its edges
+void StoreBlock(void){
+	BlockLow[MeasureBlock] = MeasureLow;
+	BlockHigh[MeasureBlock] = MeasureHigh;
+	BlockCount[MeasureBlock] = MeasureSample - MeasureStart;
+	BlockSum[MeasureBlock][0] = MeasureSum[0];
+	BlockSum[MeasureBlock][1] = MeasureSum[1];
+	BlockSquares[MeasureBlock][0] = MeasureSquares[0];
+	BlockSquares[MeasureBlock][1] = MeasureSquares[1];
+}
+
+// keep the statistics of the current block and start the next one, which replaces the oldest
+void CloseBlock(void){
+	StoreBlock();
+	MeasureBlock = (MeasureBlock + 1) & (MeasureBlocks - 1);
+	MeasureSlots = 0;
+	MeasureStart = MeasureSample;
+	MeasureLow = PairOf(4095, 4095);
+	MeasureHigh = 0;
+	MeasureSum[0] = 0;
+	MeasureSum[1] = 0;
+	MeasureSquares[0] = 0;
+	MeasureSquares[1] = 0;
+	BlockEdges[MeasureBlock][0] = 0;
+	BlockEdges[MeasureBlock][1] = 0;
+	BlockCount[MeasureBlock] = 0;
+	for(i=0;i<2;i++){
+		BlockCycles[MeasureBlock][i] = 0;
+		BlockSteps[MeasureBlock][i] = 0;
+		BlockPeriods[MeasureBlock][i] = 0;
+		BlockPeriodSquares[MeasureBlock][i] = 0;
+		BlockStepSquares[MeasureBlock][i] = 0;
+		BlockWidths[MeasureBlock][i] = 0;
+		BlockWidthSquares[MeasureBlock][i] = 0;
+		BlockAmplitudes[MeasureBlock][i] = 0;
+		BlockAmplitudeSquares[MeasureBlock][i] = 0;
+	}
+	BlockDelays[MeasureBlock] = 0;
+	BlockDelaySum[MeasureBlock] = 0;
+}
+
+// put together the statistics of the blocks in the last Slots slots stored. Of the oldest block, which only partly
+// lies in them, the share of its values in the frame is added to the counts and sums for the mean and RMS, while its
+// extremes and edges are left out. The hysteresis bands for the next frame are set around the middle of this one
+void MeasureFrame(uint16_t Slots){
+	uint32_t Low = PairOf(4095, 4095), High = 0, Count = 0, Covered = MeasureSlots, Part;
+	uint64_t Sum[2] = {0, 0}, Squares[2] = {0, 0};
+	uint32_t Edges[2] = {0, 0}, FirstEdge[2], LastEdge[2], FirstAbove[2], LastAbove[2];
+	uint32_t Cycles[2] = {0, 0}, Steps[2] = {0, 0};
+	uint64_t Periods[2] = {0, 0}, PeriodSquares[2] = {0, 0}, StepSquares[2] = {0, 0};
+	uint64_t Widths[2] = {0, 0}, WidthSquares[2] = {0, 0}, Amplitudes[2] = {0, 0}, AmplitudeSquares[2] = {0, 0};
+	uint32_t Delays = 0;
+	int64_t DelaySum = 0;
+	uint8_t k = MeasureBlock, c;
+	uint16_t Middle, Band, Upper[2], Lower[2];
+	double Mean, Square;
+	float Divider[2] = {pixel_divider1, pixel_divider2}, mV[2] = {mvpixel[Mag1], mvpixel[Mag2]};
+
+	if(MeasureOn == 0)
+		return;
+	StoreBlock();
+	CycleSeconds = secpixel[Time] / (NumSkip + 1) / 256;
+	CycleRecord = 0;
+	while(1){
+		Low = PairMin(Low, BlockLow[k]);
+		High = PairMax(High, BlockHigh[k]);
+		Count = Count + BlockCount[k];
+		for(c=0;c<2;c++){
+			Sum[c] = Sum[c] + BlockSum[k][c];
+			Squares[c] = Squares[c] + BlockSquares[k][c];
+			Cycles[c] = Cycles[c] + BlockCycles[k][c];
+			Steps[c] = Steps[c] + BlockSteps[k][c];
+			Periods[c] = Periods[c] + BlockPeriods[k][c];
+			PeriodSquares[c] = PeriodSquares[c] + BlockPeriodSquares[k][c];
+			StepSquares[c] = StepSquares[c] + BlockStepSquares[k][c];
+			Widths[c] = Widths[c] + BlockWidths[k][c];
+			WidthSquares[c] = WidthSquares[c] + BlockWidthSquares[k][c];
+			Amplitudes[c] = Amplitudes[c] + BlockAmplitudes[k][c];
+			AmplitudeSquares[c] = AmplitudeSquares[c] + BlockAmplitudeSquares[k][c];
+			if(c == 1){
+				Delays = Delays + BlockDelays[k];
+				DelaySum = DelaySum + BlockDelaySum[k];
 			}
-			else if(pixels2[i-1] <= freqref2 && pixels2[i] >= freqref2){
-				freqstart2 = 0;
-				if(l2 < TimeAvg){
-					l2++;
-				}
+			if(BlockEdges[k][c] == 0)
+				continue;
+			// blocks are visited from the newest, so the first block with an edge has the last edge
+			if(Edges[c] == 0){
+				LastEdge[c] = BlockLastEdge[k][c];
+				LastAbove[c] = BlockLastAbove[k][c];
 			}
-			if(freqstart2 == 1){
-				t2[l2] = t2[l2] + 1;
+			FirstEdge[c] = BlockFirstEdge[k][c];
+			FirstAbove[c] = BlockFirstAbove[k][c];
+			Edges[c] = Edges[c] + BlockEdges[k][c];
+		}
+		k = (k - 1) & (MeasureBlocks - 1);
+		if(k == MeasureBlock || BlockCount[k] == 0)
+			break;
+		if(Covered + MeasureBlockSlots > Slots){
+			Part = Slots - Covered;
+			Count = Count + BlockCount[k] * Part / MeasureBlockSlots;
+			for(c=0;c<2;c++){
+				Sum[c] = Sum[c] + (uint64_t)BlockSum[k][c] * Part / MeasureBlockSlots;
+				Squares[c] = Squares[c] + BlockSquares[k][c] * Part / MeasureBlockSlots;
 			}
+			break;
+		}
+		Covered = Covered + MeasureBlockSlots;
+	}
+	if(Count == 0)
+		return;
+
+	MeasureMin[0] = Low & PAIR_LOW;
+	MeasureMin[1] = Low >> 16;
+	MeasureMax[0] = High & PAIR_LOW;
+	MeasureMax[1] = High >> 16;
+	for(c=0;c<2;c++){
+		// mean and RMS around the middle of the ADC range, which is 0 V
+		Mean = (double)Sum[c] / Count;
+		MeasureMean[c] = (Mean - 2048) / Divider[c] * mV[c];
+		Square = (double)Squares[c] / Count - 4096.0 * Mean + 2048.0 * 2048.0;
+		MeasureRms[c] = sqrt((Square > 0) ? Square : 0) / Divider[c] * mV[c];
+		// whole periods lie between the first and last rising edge
+		MeasurePeriod[c] = 0;
+		MeasureDuty[c] = 0;
+		if(Edges[c] >= 2){
+			MeasurePeriod[c] = (float)(LastEdge[c] - FirstEdge[c]) / (256 * (Edges[c] - 1)) * secpixel[Time] / (NumSkip + 1);
+			MeasureDuty[c] = 25600.0f * (LastAbove[c] - FirstAbove[c]) / (LastEdge[c] - FirstEdge[c]);
+		}
+		// the spread of the periods, widths and amplitudes of the cycles that ended in the frame and of the changes
+		// in period from cycle to cycle
+		MeasureCycles[c] = Cycles[c];
+		CycleFrameEnd[c] = CycleCount[c];
+		MeasureJitter[c] = Spread(Periods[c], PeriodSquares[c], Cycles[c]) * CycleSeconds;
+		MeasureWidthSpread[c] = Spread(Widths[c], WidthSquares[c], Cycles[c]) * CycleSeconds * 256;
+		MeasureAmplitudeSpread[c] = Spread(Amplitudes[c], AmplitudeSquares[c], Cycles[c]) / Divider[c] * mV[c] / 1000;
+		MeasureCycleJitter[c] = 0;
+		if(Steps[c] >= 1)
+			MeasureCycleJitter[c] = sqrt((double)StepSquares[c] / Steps[c]) * CycleSeconds;
+	}
 
+	// the mean delay of channel 2 and its share of the mean period of channel 1
+	MeasureDelays = (Cycles[0] != 0) ? Delays : 0;
+	if(MeasureDelays != 0){
+		Mean = (double)DelaySum / Delays;
+		MeasureDelay = Mean / 256 * secpixel[Time] / (NumSkip + 1);
+		MeasurePhase = 360 * Mean * Cycles[0] / Periods[0];
+	}
+
+	// hysteresis bands reach an eighth of the peak to peak amplitude to either side of the middle. A channel
+	// with no more than noise on it gets a band above every value so noise is not counted as edges
+	for(c=0;c<2;c++){
+		Middle = (MeasureMin[c] + MeasureMax[c]) / 2;
+		Band = (MeasureMax[c] - MeasureMin[c]) >> 3;
+		Upper[c] = (Band < 4) ? 4096 : Middle + Band;
+		Lower[c] = (Band < 4) ? 0 : Middle - Band;
+	}
+	MeasureUpper = PairOf(Upper[0], Upper[1]);
+	MeasureLower = PairOf(Lower[0], Lower[1]);
+	MeasureMiddle = PairOf((Upper[0] + Lower[0]) / 2, (Upper[1] + Lower[1]) / 2);
+	MeasureReady = 1;
+}
+
+// forget the statistics of all blocks, such as when the time scale changes
+void MeasureReset(void){
+	CloseBlock();
+	for(i=0;i<MeasureBlocks;i++)
+		BlockCount[i] = 0;
+	MeasureReady = 0;
+	// the first edge needs a crossing of the middle before it
+	MeasureLevel = 3;
+	// and the first cycle starts at the first edge
+	CycleStarted = 0;
+	CycleRecord = 0;
+	CycleLast[0] = 0;
+	CycleLast[1] = 0;
+}
+
+// whether a shown measurement needs the statistics of every value: the jitter, phase and delay need the time of every
+// edge and the mean, RMS and duty cycle are better over every value. So is the statistics overlay, which follows the
+// frequency of both channels
+uint8_t MeasureNeeded(void){
+	uint8_t c, Kind;
+
+	if(StatsOn == 1)
+		return 1;
+	for(c=0;c<2;c++){
+		Kind = MeasureSelect[c];
+		if(((c == 0) ? Ch1on : Ch2on) == 1 && Kind != MEAS_VPP && Kind != MEAS_RISE && Kind != MEAS_FALL &&
+				Kind != MEAS_PWIDTH && Kind != MEAS_NWIDTH && Kind != MEAS_OVERSHOOT)
+			return 1;
+	}
+	return 0;
+}
+
+// standard deviation of Count values from their sum and the sum of their squares
+double Spread(double Sum, double Squares, uint32_t Count){
+	double Square;
+
+	if(Count < 2)
+		return 0;
+	Square = (Squares - Sum * Sum / Count) / (Count - 1);
+	return sqrt((Square > 0) ? Square : 0);
+}
+
+// go through every slot of a frozen record for its cycles, with the hysteresis bands of its frame, and give the
+// jitter and spreads of all of them. The first pass counts the cycles so the second can make each point of the
+// trend the mean of an equal share of them, which keeps the whole record in CycleRing points
+void RecordCycles(void){
+	uint32_t Pair, Before = 0, n, r, Period, Width, Amplitude, Low, High, Cross[2], Start[2], Above[2], StartAbove[2];
+	uint32_t Last[2], Cycles[2], Total[2], Group[2] = {1, 1}, Points[2], Grouped[2];
+	uint64_t GroupPeriod[2], GroupWidth[2], GroupAmplitude[2];
+	double Sums[2][7];
+	int32_t Step, Middle, Previous, Value;
+	uint8_t Pass, c, k, Level, Mid, Crossed, Rising, Started;
+	float Divider[2] = {pixel_divider1, pixel_divider2}, mV[2] = {mvpixel[Mag1], mvpixel[Mag2]};
+
+	for(Pass=0;Pass<2;Pass++){
+		// as in the decode loop, the first edge needs a crossing of the middle before it and starts the first cycle
+		Level = 3;
+		Mid = 0;
+		Started = 0;
+		Low = PairOf(4095, 4095);
+		High = 0;
+		for(c=0;c<2;c++){
+			Cycles[c] = 0;
+			Points[c] = 0;
+			Grouped[c] = 0;
+			GroupPeriod[c] = 0;
+			GroupWidth[c] = 0;
+			GroupAmplitude[c] = 0;
+			Above[c] = 0;
+			for(k=0;k<7;k++)
+				Sums[c][k] = 0;
 		}
-		// determine amount of delta time instances occur between negative triggered events
-		else if(TriggerMode == 1 && i > 0){
-			if(pixels[i-1] >= freqref1 && pixels[i] <= freqref1 && freqstart1 == 0){
-				freqstart1 = 1;
+		n = RecordStart;
+		for(r=0;r<RecordSize;r++){
+			Pair = PairGet(values, n);
+
+			// the time of the last rise through the middle while below the band, in 1/256 of a slot
+			Crossed = PairAtLeast(Pair, MeasureMiddle);
+			for(c=0;c<2;c++){
+				if((((Crossed & ~Mid & ~Level) >> c) & 1) == 0)
+					continue;
+				Previous = (Before >> (c * 16)) & PAIR_LOW;
+				Value = (Pair >> (c * 16)) & PAIR_LOW;
+				Middle = (MeasureMiddle >> (c * 16)) & PAIR_LOW;
+				Cross[c] = (r << 8) - 256 + ((Previous >= Middle) ? 0 : ((Middle - Previous) << 8) / (Value - Previous));
 			}
-			else if(pixels[i-1] >= freqref1 && pixels[i] <= freqref1 && freqstart1 == 1){
-				freqstart1 = 0;
-				if(l1 < TimeAvg){
-					l1++;
+			Mid = Crossed;
+
+			// a rising edge through the band ends the cycle started by the one before it
+			Rising = (Level | PairAtLeast(Pair, MeasureUpper)) & ~PairAtLeast(MeasureLower, Pair) & 3;
+			for(c=0;c<2;c++){
+				if((((Rising & ~Level) >> c) & 1) == 0)
+					continue;
+				if(((Started >> c) & 1) == 1){
+					Period = Cross[c] - Start[c];
+					Width = Above[c] - StartAbove[c];
+					Amplitude = ((High >> (c * 16)) & PAIR_LOW) - ((Low >> (c * 16)) & PAIR_LOW);
+					Cycles[c]++;
+					Sums[c][0] = Sums[c][0] + Period;
+					Sums[c][1] = Sums[c][1] + (double)Period * Period;
+					Sums[c][2] = Sums[c][2] + Width;
+					Sums[c][3] = Sums[c][3] + (double)Width * Width;
+					Sums[c][4] = Sums[c][4] + Amplitude;
+					Sums[c][5] = Sums[c][5] + Amplitude * Amplitude;
+					if(Cycles[c] >= 2){
+						Step = (int32_t)(Period - Last[c]);
+						Sums[c][6] = Sums[c][6] + (double)Step * Step;
+					}
+					Last[c] = Period;
+
+					// the second pass puts the cycles together into the points of the trend
+					if(Pass == 1){
+						GroupPeriod[c] = GroupPeriod[c] + Period;
+						GroupWidth[c] = GroupWidth[c] + Width;
+						GroupAmplitude[c] = GroupAmplitude[c] + Amplitude;
+						Grouped[c]++;
+						if(Grouped[c] == Group[c] || Cycles[c] == Total[c]){
+							CyclePeriod[c][Points[c]] = GroupPeriod[c] / Grouped[c];
+							CycleWidth[c][Points[c]] = GroupWidth[c] / Grouped[c];
+							CycleAmplitude[c][Points[c]] = GroupAmplitude[c] / Grouped[c];
+							Points[c]++;
+							Grouped[c] = 0;
+							GroupPeriod[c] = 0;
+							GroupWidth[c] = 0;
+							GroupAmplitude[c] = 0;
+						}
+					}
 				}
+				Started = Started | (1 << c);
+				Start[c] = Cross[c];
+				StartAbove[c] = Above[c];
+				Low = (Low & ~((uint32_t)PAIR_LOW << (c * 16))) | ((uint32_t)4095 << (c * 16));
+				High = High & ~((uint32_t)PAIR_LOW << (c * 16));
 			}
-			if(freqstart1 == 1){
-				t1[l1] = t1[l1] + 1;
-			}
+			Level = Rising;
+			Above[0] = Above[0] + (Level & 1);
+			Above[1] = Above[1] + (Level >> 1);
+			Low = PairMin(Low, Pair);
+			High = PairMax(High, Pair);
+			Before = Pair;
+			n++;
+			if(n == RecordSize)
+				n = 0;
+		}
 
-			if(pixels2[i-1] >= freqref2 && pixels2[i] <= freqref2 && freqstart2 == 0){
-				freqstart2 = 1;
-			}
-			else if(pixels2[i-1] >= freqref2 && pixels2[i] <= freqref2 && freqstart2 == 1){
-				freqstart2 = 0;
-				if(l2 < TimeAvg){
-					l2++;
+		// no more than CycleRing points, the last one can hold fewer cycles
+		for(c=0;c<2;c++){
+			Total[c] = Cycles[c];
+			Group[c] = (Cycles[c] + CycleRing - 1) / CycleRing;
+			if(Group[c] == 0)
+				Group[c] = 1;
+		}
+	}
+
+	CycleSeconds = secpixel[Time] / 256;
+	CycleRecord = 1;
+	for(c=0;c<2;c++){
+		MeasureCycles[c] = Cycles[c];
+		CycleCount[c] = Points[c];
+		CycleFrameEnd[c] = Points[c];
+		MeasureJitter[c] = Spread(Sums[c][0], Sums[c][1], Cycles[c]) * CycleSeconds;
+		MeasureWidthSpread[c] = Spread(Sums[c][2], Sums[c][3], Cycles[c]) * CycleSeconds * 256;
+		MeasureAmplitudeSpread[c] = Spread(Sums[c][4], Sums[c][5], Cycles[c]) / Divider[c] * mV[c] / 1000;
+		MeasureCycleJitter[c] = (Cycles[c] >= 2) ? sqrt(Sums[c][6] / (Cycles[c] - 1)) * CycleSeconds : 0;
+		Measures[c][MEAS_JITTER] = MeasureJitter[c];
+		Measures[c][MEAS_CYCLEJITTER] = MeasureCycleJitter[c];
+	}
+	if(Ch1on == 1 && MeasureSelect[0] != MEAS_VPP){
+		FormatMeasure(MeasureDisplay1, 0);
+		PushButtonTextSet(&g_psBotButtons[2], MeasureDisplay1);
+	}
+	if(Ch2on == 1 && MeasureSelect[1] != MEAS_VPP){
+		FormatMeasure(MeasureDisplay2, 1);
+		PushButtonTextSet(&g_psBotButtons[3], MeasureDisplay2);
+	}
+}
+
+// go through a displayed frame of channel c for its extremes, a histogram for its top and base, its mean and RMS,
+// then again for the 10%, 50% and 90% crossings between that top and base for its rise and fall times and widths.
+// Values are in V, s and %
+void MeasureSeries(uint8_t c, uint16_t *series, uint16_t *low){
+	uint16_t Low = 4095, High = 0, Top, Base, Rises = 0, Falls = 0, Highs = 0, Lows = 0, k;
+	uint32_t Sum = 0;
+	uint64_t Squares = 0;
+	int32_t Level10, Level50, Level90, Amplitude, Before, After;
+	float Up10 = 0, Up50 = 0, Down50 = 0, Down90 = 0, Rise = 0, Fall = 0, PosWidth = 0, NegWidth = 0, Mean, Square;
+	float Divider = (c == 0) ? pixel_divider1 : pixel_divider2, mV = (c == 0) ? mvpixel[Mag1] : mvpixel[Mag2];
+	// 0 below the 10% level, 1 above the 90% level, 2 before either is reached. Whole is set once the state was
+	// reached by a complete rise or fall, so the 50% crossing before it belongs to a whole pulse
+	uint8_t State = 2, Whole = 0;
+	float Level[2];
+
+	for(k=0;k<HistogramBins;k++){
+		SeriesCounts[k] = 0;
+		SeriesSums[k] = 0;
+	}
+	for(i=0;i<SERIES_LENGTH;i++){
+		After = series[i];
+		if(low[i] < Low)
+			Low = low[i];
+		if(After > High)
+			High = After;
+		SeriesCounts[After >> 4]++;
+		SeriesSums[After >> 4] += After;
+		Sum = Sum + After;
+		Squares = Squares + (uint32_t)After * After;
+	}
+
+	if(c == 0){
+		Amp1[0] = Low;
+		Amp1[1] = High;
+	}
+	else{
+		Amp2[0] = Low;
+		Amp2[1] = High;
+	}
+
+	FindLevels(SeriesCounts, SeriesSums, Low, High, Level);
+	Top = Level[1] + 0.5f;
+	Base = Level[0] + 0.5f;
+	Amplitude = Top - Base;
+	Level10 = Base + Amplitude / 10;
+	Level50 = Base + Amplitude / 2;
+	Level90 = Top - Amplitude / 10;
+
+	for(i=1;i<SERIES_LENGTH;i++){
+		After = series[i];
+
+		// remember the last crossing of each level, interpolated between the pixels
+		Before = series[i-1];
+		if(Before < Level10 && After >= Level10)
+			Up10 = i - 1 + (float)(Level10 - Before) / (After - Before);
+		if(Before < Level50 && After >= Level50)
+			Up50 = i - 1 + (float)(Level50 - Before) / (After - Before);
+		if(Before > Level90 && After <= Level90)
+			Down90 = i - 1 + (float)(Before - Level90) / (Before - After);
+		if(Before > Level50 && After <= Level50)
+			Down50 = i - 1 + (float)(Before - Level50) / (Before - After);
+
+		// a rise is complete above 90% after being below 10%, a fall below 10% after being above 90%
+		if(State != 1 && After > Level90){
+			if(State == 0){
+				Rise = Rise + (i - 1 + (float)(Level90 - Before) / (After - Before)) - Up10;
+				Rises++;
+				if(Whole == 1){
+					NegWidth = NegWidth + Up50 - Down50;
+					Lows++;
 				}
 			}
-			if(freqstart2 == 1){
-				t2[l2] = t2[l2] + 1;
+			Whole = (State == 0);
+			State = 1;
+		}
+		else if(State != 0 && After < Level10){
+			if(State == 1){
+				Fall = Fall + (i - 1 + (float)(Before - Level10) / (Before - After)) - Down90;
+				Falls++;
+				if(Whole == 1){
+					PosWidth = PosWidth + Down50 - Up50;
+					Highs++;
+				}
 			}
+			Whole = (State == 1);
+			State = 0;
+		}
+	}
+
+	Mean = (float)Sum / SERIES_LENGTH;
+	Measures[c][MEAS_MEAN] = (Mean - 2048) / Divider * mV / 1000;
+	Square = (float)Squares / SERIES_LENGTH - 4096 * Mean + 2048.0f * 2048;
+	Measures[c][MEAS_RMS] = sqrt((Square > 0) ? Square : 0) / Divider * mV / 1000;
+	Measures[c][MEAS_RISE] = (Rises != 0) ? Rise / Rises * secpixel[Time] : 0;
+	Measures[c][MEAS_FALL] = (Falls != 0) ? Fall / Falls * secpixel[Time] : 0;
+	Measures[c][MEAS_PWIDTH] = (Highs != 0) ? PosWidth / Highs * secpixel[Time] : 0;
+	Measures[c][MEAS_NWIDTH] = (Lows != 0) ? NegWidth / Lows * secpixel[Time] : 0;
+	Measures[c][MEAS_DUTY] = (Highs != 0 && Lows != 0) ?
+			100 * Measures[c][MEAS_PWIDTH] / (Measures[c][MEAS_PWIDTH] + Measures[c][MEAS_NWIDTH]) : 0;
+	Measures[c][MEAS_OVERSHOOT] = (Top > Base) ? 100.0f * (High - Top) / (Top - Base) : 0;
+}
+
+// write the chosen measurement of channel c after its short name, such as "tr12.3ns". A measurement that was not
+// found, such as a rise time without a rising edge, shows "--"
+void FormatMeasure(char *Text, uint8_t c){
+	uint8_t Kind = MeasureSelect[c];
+	char Value[12];
+
+	if(!MeasureFound(c, Kind)){
+		usprintf(Text, "%s --", MeasureNames[Kind]);
+		return;
+	}
+	FormatValue(Value, Measures[c][Kind], Kind);
+	usprintf(Text, "%s%s", MeasureNames[Kind], Value);
+}
+
+// write a value of a kind of measurement with three significant digits and a prefix
+void FormatValue(char *Text, float Value, uint8_t Kind){
+	const char *Unit = (Kind == MEAS_FREQ) ? "Hz" : MeasureUnits[Kind];
+	int8_t Exponent = -12;
+
+	if(Value < 0){
+		*Text++ = '-';
+		Value = -Value;
+	}
+	// % and deg have no prefixes, so values below a hundredth are shown as 0 to keep them in 11 characters
+	if((Unit[0] == '%' || Unit[0] == 'd') && Value < 0.005f)
+		Value = 0;
+	// count in ps, or in coarser steps when that would not fit in 64 bits
+	Value = Value * 1e12f;
+	while(Value >= 1e18f){
+		Value = Value / 1000;
+		Exponent = Exponent + 3;
+	}
+	FormatUnits(Text, Value + 0.5f, Exponent, 3, Unit);
+}
+
+// take the values binned since the last frame into the histogram shown, and find the top and base of the values
+// seen with FindLevels as MeasureSeries does for the pixels, and the noise around them
+void HistogramFrame(void){
+	uint8_t c = (Ch1on == 1) ? 0 : 1;
+	uint16_t k, Low = HistogramBins, High = 0, Middle, Peak;
+	uint32_t Count = 0;
+	float Sum = 0, Squares = 0, Level[2], Mean, Noise = 0;
+	float Divider = (c == 0) ? pixel_divider1 : pixel_divider2, mV = (c == 0) ? mvpixel[Mag1] : mvpixel[Mag2];
+	char Top[12], Base[12], Spread[12];
+
+	// values of another channel start the histogram over
+	if(HistogramShift != 4 + 16 * c){
+		HistogramShift = 4 + 16 * c;
+		for(k=0;k<HistogramBins;k++){
+			HistogramCounts[k] = 0;
+			HistogramShown[k] = 0;
 		}
+		HistogramMost = 0;
+		return;
 	}
-	// initialze totals and number of nonzero delta times found
-	totalt1 = 0;
-	totalt2 = 0;
-	NumAvgt1 = 0;
-	NumAvgt2 = 0;
-	// determine the aomount of nonzero delta times found and add to total
-	for(i=0;i<TimeAvg;i++){
-		if(t1[i] != 0){
-			totalt1 = totalt1 + t1[i];
-			NumAvgt1++;
-		}
-		if(t2[i] != 0){
-			totalt2 = totalt2 + t1[i];
-			NumAvgt2++;
-		}
-	}
-	// determine the average number of delta times
-	t1Avg = totalt1/NumAvgt1;
-	t2Avg = totalt2/NumAvgt2;
-	// reinitilze totals and number of nonzero delta times found
-	totalt1 = 0;
-	totalt2 = 0;
-	NumAvgt1 = 0;
-	NumAvgt2 = 0;
-	// determine the amount of delta times that were within +- 50% of the previous average and add to total
-	for(i=0;i<TimeAvg;i++){
-		if(t1[i] != 0 && t1[i] > t1Avg*0.5 && t1[i] < t1Avg*1.5){
-			totalt1 = totalt1 + t1[i];
-			NumAvgt1++;
-		}
-		if(t2[i] != 0&& t2[i] > t2Avg*0.5 && t2[i] < t2Avg*1.5){
-			totalt2 = totalt2 + t1[i];
-			NumAvgt2++;
-		}
-	}
-	// determine the new average number of delta times
-	t1Avg = totalt1/NumAvgt1;
-	t2Avg = totalt2/NumAvgt2;
-	// update the measured frequency if the average number of delta times is nonzero
-	if(t1Avg != 0){
-		Freq1[measnum] = 1000/(t1Avg*secpixel[Time]);
-	}
-	if(t2Avg != 0){
-		Freq2[measnum] = 1000/(t2Avg*secpixel[Time]);
+
+	// an accumulated histogram is halved before its fullest bin can overflow
+	if(HistogramOn == 2 && HistogramMost >= 0x80000000){
+		for(k=0;k<HistogramBins;k++)
+			HistogramShown[k] = HistogramShown[k] >> 1;
+	}
+	HistogramMost = 0;
+	for(k=0;k<HistogramBins;k++){
+		HistogramShown[k] = ((HistogramOn == 2) ? HistogramShown[k] : 0) + HistogramCounts[k];
+		HistogramCounts[k] = 0;
+		if(HistogramShown[k] != 0){
+			if(k < Low)
+				Low = k;
+			High = k;
+		}
+		if(HistogramShown[k] > HistogramMost)
+			HistogramMost = HistogramShown[k];
+	}
+	if(HistogramMost == 0)
+		return;
+
+	// the noise is the largest spread of the bins within HistogramSpread bins of either level on its side of the
+	// middle, each bin taken as its middle value. A spread below that of values spread evenly over one bin cannot be
+	// told from it and is shown as less than it
+	FindLevels(HistogramShown, 0, Low * 16, High * 16 + 15, Level);
+	Middle = (Low + High) / 2;
+	for(i=0;i<2;i++){
+		Sum = 0;
+		Squares = 0;
+		Count = 0;
+		Peak = Level[i] / 16;
+		for(k=(Peak >= HistogramSpread) ? Peak - HistogramSpread : 0;k<=Peak+HistogramSpread;k++){
+			if(k > High || (i == 0) != (k <= Middle))
+				continue;
+			Mean = k * 16 + 8;
+			Sum = Sum + HistogramShown[k] * Mean;
+			Squares = Squares + HistogramShown[k] * Mean * Mean;
+			Count = Count + HistogramShown[k];
+		}
+		if(Count > 1 && Squares / Count - (Sum / Count) * (Sum / Count) > Noise)
+			Noise = Squares / Count - (Sum / Count) * (Sum / Count);
+	}
+
+	FormatValue(Top, (Level[1] - 2048) / Divider * mV / 1000, MEAS_MEAN);
+	FormatValue(Base, (Level[0] - 2048) / Divider * mV / 1000, MEAS_MEAN);
+	FormatValue(Spread, ((Noise < HistogramFloor * HistogramFloor) ? HistogramFloor : sqrt(Noise)) / Divider * mV / 1000,
+			MEAS_MEAN);
+	usnprintf(HistogramDisplay, sizeof(HistogramDisplay), "top %s  base %s  noise %s%s   ", Top, Base,
+			(Noise < HistogramFloor * HistogramFloor) ? "<" : "", Spread);
+}
+
+// the base and top of values binned in HistogramBins bins of 16 values, the lowest and highest of which are Low and
+// High. Each is the mean of the fullest bin in the lower or upper half of the values and the bins next to it in that
+// half, when the fullest bin holds at least a tenth of the values, otherwise it is the extreme of that half. Sums
+// has the sum of the values in each bin, or is 0 when the middle of a bin has to stand for its values
+void FindLevels(const uint32_t *Counts, const uint32_t *Sums, uint16_t Low, uint16_t High, float *Level){
+	uint16_t Middle = ((Low + High) / 2) >> 4, Start, End, Peak, k;
+	uint32_t Total = 0, Count;
+	float Sum;
+	uint8_t h;
+
+	for(k=Low>>4;k<=High>>4;k++)
+		Total = Total + Counts[k];
+	Level[0] = Low;
+	Level[1] = High;
+	for(h=0;h<2;h++){
+		Start = (h == 0) ? Low >> 4 : Middle + 1;
+		End = (h == 0) ? Middle : High >> 4;
+		if(Start > End)
+			continue;
+		Peak = Start;
+		for(k=Start;k<=End;k++)
+			if(Counts[k] > Counts[Peak])
+				Peak = k;
+		if(Counts[Peak] == 0 || Counts[Peak] < Total / 10)
+			continue;
+		Count = 0;
+		Sum = 0;
+		for(k=(Peak > Start) ? Peak - 1 : Peak;k<=End && k<=Peak+1;k++){
+			Count = Count + Counts[k];
+			Sum = Sum + ((Sums != 0) ? Sums[k] : Counts[k] * (k * 16 + 8.0f));
+		}
+		Level[h] = Sum / Count;
+	}
+}
+
+// draw the histogram as bars to the left of the right edge of the waveform, each row showing the fullest bin of
+// the values it stands for. DWaveForm draws them under the signals and writes the top, base and noise over them
+void DrawHistogram(void){
+	int16_t Row, First, Last, k;
+	uint16_t Mid = (HistogramShift == 4) ? midlevel1 : midlevel2;
+	float Divider = (HistogramShift == 4) ? pixel_divider1 : pixel_divider2;
+	uint32_t Most;
+	uint8_t Bar;
+
+	for(Row=29;Row<=210;Row++){
+		// rows go up as values go up, a row shows the values from half a row below it to half a row above it
+		First = ((Mid - Row - 0.5f) * Divider) / 16;
+		Last = ((Mid - Row + 0.5f) * Divider) / 16;
+		if(First < 0)
+			First = 0;
+		if(Last >= HistogramBins)
+			Last = HistogramBins - 1;
+		Most = 0;
+		for(k=First;k<=Last;k++)
+			if(HistogramShown[k] > Most)
+				Most = HistogramShown[k];
+		Bar = (HistogramMost != 0 && Mid - Row + 0.5f >= 0) ? (uint64_t)Most * HistogramWidth / HistogramMost : 0;
+
+		if(Bar < HistogramBar[Row-29]){
+			GrContextForegroundSet(&sContext, ClrBlack);
+			GrLineDrawH(&sContext, 317 - HistogramBar[Row-29], 316 - Bar, Row);
+		}
+		if(Bar > 0){
+			GrContextForegroundSet(&sContext, ClrGray);
+			GrLineDrawH(&sContext, 317 - Bar, 316, Row);
+		}
+		HistogramBar[Row-29] = Bar;
+	}
+}
+
+// draw the periods, widths and amplitudes of the cycles of the last frame or frozen record from left to right
+// below the statistics when a jitter measurement is chosen for a channel that is on, each scaled from its lowest
+// to its highest value, and write the number of cycles, the range of periods and the spreads of the widths and
+// amplitudes under them. The last trend is drawn over in black first
+void DrawTrend(void){
+	uint8_t c = 2, t;
+	uint16_t k, Points = 0;
+	uint32_t n, Least[3], Most[3];
+	int16_t Row;
+	char Short[12], Long[12], Width[12], Amplitude[12];
+	const uint32_t Colors[3] = {ClrGreen, ClrCyan, ClrMagenta};
+
+	if(Ch1on == 1 && (MeasureSelect[0] == MEAS_JITTER || MeasureSelect[0] == MEAS_CYCLEJITTER))
+		c = 0;
+	else if(Ch2on == 1 && (MeasureSelect[1] == MEAS_JITTER || MeasureSelect[1] == MEAS_CYCLEJITTER))
+		c = 1;
+
+	GrContextForegroundSet(&sContext, ClrBlack);
+	for(t=0;t<3;t++){
+		for(k=1;k<TrendPoints;k++)
+			GrLineDraw(&sContext, 7 + (k-1) * 309 / (TrendPoints-1), TrendRow[t][k-1], 7 + k * 309 / (TrendPoints-1),
+					TrendRow[t][k]);
+	}
+	if(c != 2){
+		// the newest cycles of the frame that are still in the ring, up to one per pixel
+		Points = (MeasureCycles[c] > CycleRing) ? CycleRing : MeasureCycles[c];
+		if(Points > CycleCount[c])
+			Points = CycleCount[c];
+	}
+	if(Points < 2){
+		if(TrendPoints != 0){
+			GrStringDraw(&sContext, "                                                       ", -1, 8, 142, 1);
+			TrendPoints = 0;
+		}
+		return;
+	}
+
+	for(t=0;t<3;t++){
+		Least[t] = 0xFFFFFFFF;
+		Most[t] = 0;
+	}
+	for(k=0;k<Points;k++){
+		n = (CycleFrameEnd[c] - Points + k) & (CycleRing - 1);
+		for(t=0;t<3;t++){
+			if(CycleValue(t, c, n) < Least[t])
+				Least[t] = CycleValue(t, c, n);
+			if(CycleValue(t, c, n) > Most[t])
+				Most[t] = CycleValue(t, c, n);
+		}
+	}
+	for(t=0;t<3;t++){
+		GrContextForegroundSet(&sContext, Colors[t]);
+		for(k=0;k<Points;k++){
+			n = (CycleFrameEnd[c] - Points + k) & (CycleRing - 1);
+			Row = 140 - ((Most[t] > Least[t]) ? (uint64_t)(CycleValue(t, c, n) - Least[t]) * 28 / (Most[t] - Least[t]) : 14);
+			TrendRow[t][k] = Row;
+			if(k > 0)
+				GrLineDraw(&sContext, 7 + (k-1) * 309 / (Points-1), TrendRow[t][k-1], 7 + k * 309 / (Points-1), Row);
+		}
+	}
+	TrendPoints = Points;
+
+	FormatValue(Short, Least[0] * CycleSeconds, MEAS_JITTER);
+	FormatValue(Long, Most[0] * CycleSeconds, MEAS_JITTER);
+	FormatValue(Width, MeasureWidthSpread[c], MEAS_PWIDTH);
+	FormatValue(Amplitude, MeasureAmplitudeSpread[c], MEAS_VPP);
+	usnprintf(TrendDisplay, sizeof(TrendDisplay), "%u cycles  %s..%s  sd w%s a%s   ", MeasureCycles[c], Short, Long,
+			Width, Amplitude);
+	GrContextFontSet(&sContext, g_psFontCm12);
+	GrContextBackgroundSet(&sContext, ClrBlack);
+	GrStringDraw(&sContext, TrendDisplay, -1, 8, 142, 1);
+}
+
+// step the histogram from off to each frame to accumulated and back to off
+void HistogramSelect(tWidget *psWidget){
+	tRectangle Rect;
+
+	HistogramOn = (HistogramOn + 1) % 3;
+	for(i=0;i<HistogramBins;i++){
+		HistogramCounts[i] = 0;
+		HistogramShown[i] = 0;
+	}
+	HistogramMost = 0;
+	HistogramDisplay[0] = 0;
+	if(HistogramOn == 0){
+		PushButtonTextSet(&g_sPushBtnHistogram, "Hist off");
+		Rect.i16XMin = 317 - HistogramWidth;
+		Rect.i16YMin = 29;
+		Rect.i16XMax = 316;
+		Rect.i16YMax = 210;
+		GrContextForegroundSet(&sContext, ClrBlack);
+		GrRectFill(&sContext, &Rect);
+		Rect.i16XMin = 8;
+		Rect.i16YMin = 183;
+		Rect.i16YMax = 195;
+		GrRectFill(&sContext, &Rect);
+		for(i=0;i<182;i++)
+			HistogramBar[i] = 0;
+	}
+	else if(HistogramOn == 1)
+		PushButtonTextSet(&g_sPushBtnHistogram, "Hist");
+	else
+		PushButtonTextSet(&g_sPushBtnHistogram, "Hist acc");
+	WidgetPaint((tWidget *) &g_sPushBtnHistogram);
+}
+
+// add the value of a measurement of a frame to its running statistics
+void StatAdd(uint8_t c, uint8_t k, float Value){
+	float Delta = Value - StatMean[c][k];
+
+	StatLast[c][k] = Value;
+	StatCount[c][k]++;
+	StatMean[c][k] = StatMean[c][k] + Delta / StatCount[c][k];
+	StatM2[c][k] = StatM2[c][k] + Delta * (Value - StatMean[c][k]);
+	if(StatCount[c][k] == 1 || Value < StatMin[c][k])
+		StatMin[c][k] = Value;
+	if(StatCount[c][k] == 1 || Value > StatMax[c][k])
+		StatMax[c][k] = Value;
+}
+
+// start the statistics of all measurements over
+void StatReset(void){
+	uint8_t c, k;
+
+	for(c=0;c<2;c++){
+		for(k=0;k<StatKinds;k++){
+			StatCount[c][k] = 0;
+			StatLast[c][k] = 0;
+			StatMean[c][k] = 0;
+			StatM2[c][k] = 0;
+		}
+	}
+}
+
+// the statistics button of the channels menu starts the statistics over and leaves them shown, they are drawn again
+// with the next frame once the menu is closed
+void StatRestart(tWidget *psWidget){
+	StatReset();
+}
+
+// write the statistics of the frequency and the chosen measurement of each channel that is on at the top of the
+// waveform, each as its value on the last frame, mean, standard deviation, extremes and number of frames
+void DrawStats(void){
+	uint8_t c, Line = 0, Kinds[2], n;
+	// a line is at most a name, five values of 11 characters, a count of 10 digits and the labels and padding
+	char Text[96], Last[12], Mean[12], Deviation[12], Min[12], Max[12];
+
+	GrContextFontSet(&sContext, g_psFontCm12);
+	GrContextBackgroundSet(&sContext, ClrBlack);
+	for(c=0;c<2;c++){
+		if((c == 0 && Ch1on == 0) || (c == 1 && Ch2on == 0))
+			continue;
+		GrContextForegroundSet(&sContext, (c == 0) ? ClrRed : ClrYellow);
+		Kinds[0] = MEAS_FREQ;
+		Kinds[1] = MeasureSelect[c];
+		for(n=0;n<2;n++){
+			FormatValue(Last, StatLast[c][Kinds[n]], Kinds[n]);
+			FormatValue(Mean, StatMean[c][Kinds[n]], Kinds[n]);
+			FormatValue(Deviation, (StatCount[c][Kinds[n]] > 1) ?
+					sqrt(StatM2[c][Kinds[n]] / (StatCount[c][Kinds[n]] - 1)) : 0, Kinds[n]);
+			FormatValue(Min, StatMin[c][Kinds[n]], Kinds[n]);
+			FormatValue(Max, StatMax[c][Kinds[n]], Kinds[n]);
+			usnprintf(Text, sizeof(Text), "%d%s %s m%s sd%s %s..%s n%u   ", c + 1, (Kinds[n] == MEAS_FREQ) ? "f" :
+					(Kinds[n] == MEAS_VPP) ? "pp" : MeasureNames[Kinds[n]], Last, Mean, Deviation, Min, Max,
+					StatCount[c][Kinds[n]]);
+			GrStringDraw(&sContext, Text, -1, 8, 44 + Line * 13, 1);
+			Line++;
+		}
+	}
+}
+
+// estimate the period of a series of pixels in pixels from the interpolated rising crossings of the middle between
+// its extremes. A crossing only counts once the series has been below and then above a band around the middle
+float PixelPeriod(uint16_t *series, uint16_t Low, uint16_t High){
+	int32_t Middle = (Low + High) / 2, Band = (High - Low) >> 3;
+	float Cross = 0, First = 0, Last = 0;
+	uint16_t Edges = 0;
+	uint8_t Above = 1;
+
+	// no more than noise on the series
+	if(Band < 4)
+		return 0;
+
+	for(i=1;i<SERIES_LENGTH;i++){
+		if(series[i-1] < Middle && series[i] >= Middle)
+			Cross = i - 1 + (float)(Middle - series[i-1]) / (series[i] - series[i-1]);
+		if(Above == 0 && series[i] > Middle + Band){
+			Above = 1;
+			if(Edges == 0)
+				First = Cross;
+			Last = Cross;
+			Edges++;
+		}
+		else if(series[i] <= Middle - Band){
+			Above = 0;
+		}
+	}
+	if(Edges < 2)
+		return 0;
+	return (Last - First) / (Edges - 1);
+}
+
+// estimate the frequencies from the periods of the displayed frame, used when the statistics of the values are
+// not available such as for a frozen record
+void PixelFrequency(void){
+	float Period1 = PixelPeriod(pixels, Amp1[0], Amp1[1]), Period2 = PixelPeriod(pixels2, Amp2[0], Amp2[1]);
+
+	Freq1[measnum] = (Period1 != 0) ? 1000/(Period1*secpixel[Time]) : 0;
+	Freq2[measnum] = (Period2 != 0) ? 1000/(Period2*secpixel[Time]) : 0;
+}
+
+// function to update the voltage and frequency measurements
+void UpdateMeasurements(void){
+	// lowest value of each pixel, which has its own array in peak detect and envelope modes
+	uint16_t *Low1 = (CaptureMode == 3 || CaptureMode == 5) ? pixelsLow : pixels;
+	uint16_t *Low2 = (CaptureMode == 3 || CaptureMode == 5) ? pixelsLow2 : pixels2;
+	uint32_t FineLow1, FineHigh1, FineLow2, FineHigh2;
+	uint8_t Stream = MeasureReady, c;
+
+	// the extremes and every other measurement of the displayed frame
+	MeasureSeries(0, pixels, Low1);
+	MeasureSeries(1, pixels2, Low2);
+	if(HistogramOn != 0)
+		HistogramFrame();
+
+	// use the statistics of every value of the frame when they are ready. The extremes of the values stand for the
+	// frame in normal and peak detect modes, the averaging modes show fewer of them than were decoded
+	if(MeasureReady == 1){
+		MeasureReady = 0;
+		if(CaptureMode == 0 || CaptureMode == 3){
+			Amp1[0] = MeasureMin[0];
+			Amp1[1] = MeasureMax[0];
+			Amp2[0] = MeasureMin[1];
+			Amp2[1] = MeasureMax[1];
+		}
+		Freq1[measnum] = (MeasurePeriod[0] != 0) ? 1000/MeasurePeriod[0] : 0;
+		Freq2[measnum] = (MeasurePeriod[1] != 0) ? 1000/MeasurePeriod[1] : 0;
+	}
+	// otherwise count the pixels between crossings of the displayed frame
+	else{
+		PixelFrequency();
 	}
 
 	// Calcualte peak to peak amplitude in pixels
@@ -2924,6 +4974,58 @@ void UpdateMeasurements(void){
 	Amp1[3] = (Amp1[2]/pixel_divider1)*mvpixel[Mag1];
 	Amp2[3] = (Amp2[2]/pixel_divider2)*mvpixel[Mag2];
 
+	// in hi-res mode use the extra bits of the averaged values for the peak to peak amplitude
+	if(CaptureMode == 4){
+		FineLow1 = 0xFFFFFFFF;
+		FineHigh1 = 0;
+		FineLow2 = 0xFFFFFFFF;
+		FineHigh2 = 0;
+		for(i=0;i<SERIES_LENGTH;i++){
+			if(finepixels[i] < FineLow1)
+				FineLow1 = finepixels[i];
+			if(finepixels[i] > FineHigh1)
+				FineHigh1 = finepixels[i];
+			if(finepixels2[i] < FineLow2)
+				FineLow2 = finepixels2[i];
+			if(finepixels2[i] > FineHigh2)
+				FineHigh2 = finepixels2[i];
+		}
+		Amp1[3] = ((FineHigh1 - FineLow1)/(65536*pixel_divider1))*mvpixel[Mag1];
+		Amp2[3] = ((FineHigh2 - FineLow2)/(65536*pixel_divider2))*mvpixel[Mag2];
+	}
+
+	// mean, RMS and duty cycle over every value are better than over the pixels
+	Measures[0][MEAS_VPP] = Amp1[3] / 1000.0f;
+	Measures[1][MEAS_VPP] = Amp2[3] / 1000.0f;
+	for(c=0;c<2;c++){
+		if(Stream == 1){
+			Measures[c][MEAS_MEAN] = MeasureMean[c] / 1000;
+			Measures[c][MEAS_RMS] = MeasureRms[c] / 1000;
+			if(MeasurePeriod[c] != 0)
+				Measures[c][MEAS_DUTY] = MeasureDuty[c];
+		}
+		// the jitter needs the time of every edge
+		Measures[c][MEAS_JITTER] = (Stream == 1) ? MeasureJitter[c] : 0;
+		Measures[c][MEAS_CYCLEJITTER] = (Stream == 1) ? MeasureCycleJitter[c] : 0;
+		// and so do the phase and delay, which need both channels
+		if(Stream == 0 || Ch1on == 0 || Ch2on == 0)
+			MeasureDelays = 0;
+		Measures[c][MEAS_PHASE] = (MeasureDelays != 0) ? MeasurePhase : 0;
+		Measures[c][MEAS_DELAY] = (MeasureDelays != 0) ? MeasureDelay : 0;
+	}
+
+	// add the measurements of this frame to the statistics, leaving out those that were not found
+	for(c=0;c<2;c++){
+		for(i=0;i<MeasureKinds;i++){
+			if(MeasureFound(c, i))
+				StatAdd(c, i, Measures[c][i]);
+		}
+	}
+	if(Freq1[measnum] != 0)
+		StatAdd(0, MEAS_FREQ, Freq1[measnum] / 1000.0f);
+	if(Freq2[measnum] != 0)
+		StatAdd(1, MEAS_FREQ, Freq2[measnum] / 1000.0f);
+
 	// increment number of measurements found
 	measnum++;
 	// calculate frequency to be displayed when the desired number of measurements has been found
@@ -2940,8 +5042,8 @@ void UpdateMeasurements(void){
 				NumFreqs2++;
 			}
 		}
-		Frequency1 = Frequency1Total/NumFreqs1;
-		Frequency2 = Frequency2Total/NumFreqs2;
+		Frequency1 = (NumFreqs1 != 0) ? Frequency1Total/NumFreqs1 : 0;
+		Frequency2 = (NumFreqs2 != 0) ? Frequency2Total/NumFreqs2 : 0;
 		Frequency1Total = 0;
 		Frequency2Total = 0;
 		NumFreqs1 = 0;
@@ -2952,302 +5054,41 @@ void UpdateMeasurements(void){
 			Freq2[i] = 0;
 		}
 
-		// display frequency value using ASCII characters if channel 1 is on
-		if(Ch1on == 1){
-			if(Frequency1 > 1000000000){
-				FreqDisplay1[0] = (Frequency1/1000000000)%10 + 48;
-				FreqDisplay1[1] = 46; // '.'
-				FreqDisplay1[2] = (Frequency1/1000000000)%10 + 48;
-				FreqDisplay1[3] = (Frequency1/100000000)%10 + 48;
-				FreqDisplay1[4] = 32; // ' '
-				FreqDisplay1[5] = 77; // 'M'
-				FreqDisplay1[6] = 72; // 'H'
-				FreqDisplay1[7] = 122; // 'z'
-				FreqDisplay1[8] = 0;
-			}
-			else if(Frequency1 > 100000000){
-				FreqDisplay1[0] = (Frequency1/100000000)%10 + 48;
-				FreqDisplay1[1] = (Frequency1/10000000)%10 + 48;
-				FreqDisplay1[2] = (Frequency1/1000000)%10 + 48;
-				FreqDisplay1[3] = 32; // ' '
-				FreqDisplay1[4] = 107; // 'k'
-				FreqDisplay1[5] = 72; // 'H'
-				FreqDisplay1[6] = 122; // 'z'
-				FreqDisplay1[7] = 0;
-				FreqDisplay1[8] = 0;
-			}
-			else if(Frequency1 > 10000000){
-				FreqDisplay1[0] = (Frequency1/10000000)%10 + 48;
-				FreqDisplay1[1] = (Frequency1/1000000)%10 + 48;
-				FreqDisplay1[2] = 46; // '.'
-				FreqDisplay1[3] = (Frequency1/100000)%10 + 48;
-				FreqDisplay1[4] = 32; // ' ';
-				FreqDisplay1[5] = 107; // 'k'
-				FreqDisplay1[6] = 72; // 'H'
-				FreqDisplay1[7] = 122; // 'z'
-				FreqDisplay1[8] = 0;
-			}
-			else if(Frequency1 > 1000000){
-				FreqDisplay1[0] = (Frequency1/1000000)%10 + 48;
-				FreqDisplay1[1] = 46; // '.'
-				FreqDisplay1[2] = (Frequency1/100000)%10 + 48;
-				FreqDisplay1[3] = (Frequency1/10000)%10 + 48;
-				FreqDisplay1[4] = 32; // ' ';
-				FreqDisplay1[5] = 107; // 'k'
-				FreqDisplay1[6] = 72; // 'H'
-				FreqDisplay1[7] = 122; // 'z'
-				FreqDisplay1[8] = 0;
-			}
-			else if(Frequency1 > 100000){
-				FreqDisplay1[0] = (Frequency1/100000)%10 + 48;
-				FreqDisplay1[1] = (Frequency1/10000)%10 + 48;
-				FreqDisplay1[2] = (Frequency1/1000)%10 + 48;
-				FreqDisplay1[3] = 32; // ' ';
-				FreqDisplay1[4] = 72; // 'H'
-				FreqDisplay1[5] = 122; // 'z'
-				FreqDisplay1[6] = 0;
-				FreqDisplay1[7] = 0;
-				FreqDisplay1[8] = 0;
-			}
-			else if(Frequency1 > 10000){
-				FreqDisplay1[0] = (Frequency1/10000)%10 + 48;
-				FreqDisplay1[1] = (Frequency1/1000)%10 + 48;
-				FreqDisplay1[2] = 46; // '.'
-				FreqDisplay1[3] = (Frequency1/100)%10 + 48;
-				FreqDisplay1[4] = 32; // ' ';
-				FreqDisplay1[5] = 72; // 'H'
-				FreqDisplay1[6] = 122; // 'z'
-				FreqDisplay1[7] = 0;
-				FreqDisplay1[8] = 0;
-			}
-			else if(Frequency1 > 1000){
-				FreqDisplay1[0] = (Frequency1/1000)%10 + 48;
-				FreqDisplay1[1] = 46; // '.'
-				FreqDisplay1[2] = (Frequency1/100)%10 + 48;
-				FreqDisplay1[3] = (Frequency1/10)%10 + 48;
-				FreqDisplay1[4] = 32; // ' ';
-				FreqDisplay1[5] = 72; // 'H'
-				FreqDisplay1[6] = 122; // 'z'
-				FreqDisplay1[7] = 0;
-				FreqDisplay1[8] = 0;
-			}
-			else{
-				FreqDisplay1[0] = (Frequency1/100)%10 + 48;
-				FreqDisplay1[1] = (Frequency1/10)%10 + 48;
-				FreqDisplay1[2] = Frequency1%10 + 48;
-				FreqDisplay1[3] = 32; // ' ';
-				FreqDisplay1[4] = 109; // 'm'
-				FreqDisplay1[5] = 72; // 'H'
-				FreqDisplay1[6] = 122; // 'z'
-				FreqDisplay1[7] = 0;
-				FreqDisplay1[8] = 0;
-				// create space if leading digit is 0
-				if(FreqDisplay1[0] == 48){
-					FreqDisplay1[0] = 32; // ' ';
-					if(FreqDisplay1[1] == 48){
-						FreqDisplay1[1] = 32; // ' ';
-					}
-				}
-			}
-		}
-		// display 'Hz' if channel 1 not on
-		else{
-			FreqDisplay1[0] = 72; // 'H'
-			FreqDisplay1[1] = 122; // 'z'
-			FreqDisplay1[2] = 0;
-		}
-
-		// display frequency value using ASCII characters if channel 2 is on
-		if(Ch2on == 1){
-			if(Frequency2 > 1000000000){
-				FreqDisplay2[0] = (Frequency2/1000000000)%10 + 48;
-				FreqDisplay2[1] = 46; // '.'
-				FreqDisplay2[2] = (Frequency2/1000000000)%10 + 48;
-				FreqDisplay2[3] = (Frequency2/100000000)%10 + 48;
-				FreqDisplay2[4] = 32; // ' ';
-				FreqDisplay2[5] = 77; // 'M';
-				FreqDisplay2[6] = 72; // 'H'
-				FreqDisplay2[7] = 122; // 'z'
-				FreqDisplay2[8] = 0;
-			}
-			else if(Frequency2 > 100000000){
-				FreqDisplay2[0] = (Frequency2/100000000)%10 + 48;
-				FreqDisplay2[1] = (Frequency2/10000000)%10 + 48;
-				FreqDisplay2[2] = (Frequency2/1000000)%10 + 48;
-				FreqDisplay2[3] = 32; // ' ';
-				FreqDisplay2[4] = 107; // 'k'
-				FreqDisplay2[5] = 72; // 'H'
-				FreqDisplay2[6] = 122; // 'z'
-				FreqDisplay2[7] = 0;
-				FreqDisplay2[8] = 0;
-			}
-			else if(Frequency2 > 10000000){
-				FreqDisplay2[0] = (Frequency2/10000000)%10 + 48;
-				FreqDisplay2[1] = (Frequency2/1000000)%10 + 48;
-				FreqDisplay2[2] = 46; // '.'
-				FreqDisplay2[3] = (Frequency2/100000)%10 + 48;
-				FreqDisplay2[4] = 32; // ' ';
-				FreqDisplay2[5] = 107; // 'k'
-				FreqDisplay2[6] = 72; // 'H'
-				FreqDisplay2[7] = 122; // 'z'
-				FreqDisplay2[8] = 0;
-			}
-			else if(Frequency2 > 1000000){
-				FreqDisplay2[0] = (Frequency2/1000000)%10 + 48;
-				FreqDisplay2[1] = 46; // '.'
-				FreqDisplay2[2] = (Frequency2/100000)%10 + 48;
-				FreqDisplay2[3] = (Frequency2/10000)%10 + 48;
-				FreqDisplay2[4] = 32; // ' ';
-				FreqDisplay2[5] = 107; // 'k'
-				FreqDisplay2[6] = 72; // 'H'
-				FreqDisplay2[7] = 122; // 'z'
-				FreqDisplay2[8] = 0;
-			}
-			else if(Frequency2 > 100000){
-				FreqDisplay2[0] = (Frequency2/100000)%10 + 48;
-				FreqDisplay2[1] = (Frequency2/10000)%10 + 48;
-				FreqDisplay2[2] = (Frequency2/1000)%10 + 48;
-				FreqDisplay2[3] = 32; // ' ';
-				FreqDisplay2[4] = 72; // 'H'
-				FreqDisplay2[5] = 122; // 'z'
-				FreqDisplay2[6] = 0;
-				FreqDisplay2[7] = 0;
-				FreqDisplay2[8] = 0;
-			}
-			else if(Frequency2 > 10000){
-				FreqDisplay2[0] = (Frequency2/10000)%10 + 48;
-				FreqDisplay2[1] = (Frequency2/1000)%10 + 48;
-				FreqDisplay2[2] = 46; // '.'
-				FreqDisplay2[3] = (Frequency2/100)%10 + 48;
-				FreqDisplay2[4] = 32; // ' ';
-				FreqDisplay2[5] = 72; // 'H'
-				FreqDisplay2[6] = 122; // 'z'
-				FreqDisplay2[7] = 0;
-				FreqDisplay2[8] = 0;
-			}
-			else if(Frequency2 > 1000){
-				FreqDisplay2[0] = (Frequency2/1000)%10 + 48;
-				FreqDisplay2[1] = 46; // '.'
-				FreqDisplay2[2] = (Frequency2/100)%10 + 48;
-				FreqDisplay2[3] = (Frequency2/10)%10 + 48;
-				FreqDisplay2[4] = 32; // ' ';
-				FreqDisplay2[5] = 72; // 'H'
-				FreqDisplay2[6] = 122; // 'z'
-				FreqDisplay2[7] = 0;
-				FreqDisplay2[8] = 0;
-			}
-			else{
-				FreqDisplay2[0] = (Frequency2/100)%10 + 48;
-				FreqDisplay2[1] = (Frequency2/10)%10 + 48;
-				FreqDisplay2[2] = Frequency2%10 + 48;
-				FreqDisplay2[3] = 32; // ' ';
-				FreqDisplay2[4] = 109; // 'm'
-				FreqDisplay2[5] = 72; // 'H'
-				FreqDisplay2[6] = 122; // 'z'
-				FreqDisplay2[7] = 0;
-				FreqDisplay2[8] = 0;
-				// create space if leading with 0
-				if(FreqDisplay2[0] == 48){
-					FreqDisplay2[0] = 32; // ' ';
-					if(FreqDisplay2[1] == 48){
-						FreqDisplay2[1] = 32; // ' ';
-					}
-				}
-			}
-		}
-		// display 'Hz' if channel 2 not on
-		else{
-			FreqDisplay2[0] = 72; // 'H'
-			FreqDisplay2[1] = 122; // 'z'
-			FreqDisplay2[2] = 0;
-		}
+		// display the frequency of each channel that is on with four significant digits
+		if(Ch1on == 1)
+			FormatUnits(FreqDisplay1, Frequency1, -3, 4, "Hz");
+		else
+			usprintf(FreqDisplay1, "Hz");
+		if(Ch2on == 1)
+			FormatUnits(FreqDisplay2, Frequency2, -3, 4, "Hz");
+		else
+			usprintf(FreqDisplay2, "Hz");
 
 		PushButtonTextSet(&g_psBotButtons[0], FreqDisplay1);
 		PushButtonTextSet(&g_psBotButtons[1], FreqDisplay2);
 	}
 
-	// display voltage measurement for channel 1 with ASCII characters
-	if(Ch1on == 1){
-		if(Amp1[3] < 1000){
-			MagDisplay1[0] = (Amp1[3]/100)%10 + 48;
-			MagDisplay1[1] = (Amp1[3]/10)%10 + 48;
-			MagDisplay1[2] = Amp1[3]%10 + 48;
-			MagDisplay1[3] = 32; // ' ';
-			MagDisplay1[4] = 109; // 'm'
-			MagDisplay1[5] = 86; // 'V'
-			MagDisplay1[6] = 0;
-			// create spaces for leading 0
-			if(MagDisplay1[0] == 48){
-				MagDisplay1[0] = 32; // ' ';
-				if(MagDisplay1[1] == 48){
-					MagDisplay1[1] = 32; // ' ';
-				}
-			}
-		}
-		else{
-			MagDisplay1[0] = (Amp1[3]/10000)%10 + 48;
-			MagDisplay1[1] = (Amp1[3]/1000)%10 + 48;
-			MagDisplay1[2] = 46; // '.'
-			MagDisplay1[3] = (Amp1[3]/100)%10 + 48;
-			MagDisplay1[4] = (Amp1[3]/10)%10 + 48;
-			MagDisplay1[5] = 32; // ' ';
-			MagDisplay1[6] = 86; // 'V'
-			// create spaces for leading 0
-			if(MagDisplay1[0] == 48){
-				MagDisplay1[0] = 32; // ' ';
-				if(MagDisplay1[1] == 48){
-					MagDisplay1[1] = 32; // ' ';
-				}
-			}
-		}
-	}
-	// display 'V' if channel 1 not on
-	else{
-		MagDisplay1[0] = 86; // 'V'
-		MagDisplay1[1] = 0;
-	}
-	// display voltage measurement for channel 2 with ASCII characters
-	if(Ch2on == 1){
-		if(Amp2[3] < 1000){
-			MagDisplay2[0] = (Amp2[3]/100)%10 + 48;
-			MagDisplay2[1] = (Amp2[3]/10)%10 + 48;
-			MagDisplay2[2] = Amp2[3]%10 + 48;
-			MagDisplay2[3] = 32; // ' ';
-			MagDisplay2[4] = 109; // 'm'
-			MagDisplay2[5] = 86; // 'V'
-			MagDisplay2[6] = 0;
-			// create spaces of leading 0
-			if(MagDisplay2[0] == 48){
-				MagDisplay2[0] = 32; // ' ';
-				if(MagDisplay2[1] == 48){
-					MagDisplay2[1] = 32; // ' ';
-				}
-			}
-		}
-		else{
-			MagDisplay2[0] = (Amp2[3]/10000)%10 + 48;
-			MagDisplay2[1] = (Amp2[3]/1000)%10 + 48;
-			MagDisplay2[2] = 46; // '.'
-			MagDisplay2[3] = (Amp2[3]/100)%10 + 48;
-			MagDisplay2[4] = (Amp2[3]/10)%10 + 48;
-			MagDisplay2[5] = 32; // ' ';
-			MagDisplay2[6] = 86; // 'V'
-			// create spaces for leading 0
-			if(MagDisplay2[0] == 48){
-				MagDisplay2[0] = 32; // ' ';
-				if(MagDisplay2[1] == 48){
-					MagDisplay2[1] = 32; // ' ';
-				}
-			}
-		}
-	}
-	// display 'V' if channel 2 not on
-	else{
-		MagDisplay2[0] = 86; // 'V'
-		MagDisplay2[1] = 0;
-	}
+	// display the peak to peak voltage of each channel that is on
+	if(Ch1on == 1)
+		FormatUnits(MagDisplay1, Amp1[3], -3, 3, "V");
+	else
+		usprintf(MagDisplay1, "V");
+	if(Ch2on == 1)
+		FormatUnits(MagDisplay2, Amp2[3], -3, 3, "V");
+	else
+		usprintf(MagDisplay2, "V");
 	PushButtonTextSet(&g_psBotButtons[2], MagDisplay1);
 	PushButtonTextSet(&g_psBotButtons[3], MagDisplay2);
+
+	// show the chosen measurement instead of the peak to peak voltage
+	if(Ch1on == 1 && MeasureSelect[0] != MEAS_VPP){
+		FormatMeasure(MeasureDisplay1, 0);
+		PushButtonTextSet(&g_psBotButtons[2], MeasureDisplay1);
+	}
+	if(Ch2on == 1 && MeasureSelect[1] != MEAS_VPP){
+		FormatMeasure(MeasureDisplay2, 1);
+		PushButtonTextSet(&g_psBotButtons[3], MeasureDisplay2);
+	}
 }
 
 void CalibrateOffset(){
@@ -0,0 +1,118 @@
+// Host benchmark of the decode pass and of drawing a frozen record. PixelsCalculation is timed per value in every
+// acquire mode at a time scale that stores every value and at one that skips 24 of every 25, RenderRecord per
+// view at 1, 8 and 64 ring slots per pixel in normal and peak detect modes. The decode pass is timed with the
+// measurements taken from the pixels and again with the statistics overlay shown, which needs the statistics of
+// every value; older versions of main.c without the overlay are timed once. Each time is the best of several
+// runs of thread CPU time, as single runs on a busy host swing by more than the differences measured. The
+// measurements of each frame are not timed: UpdateMeasurements is replaced by an empty one, which also lets older
+// versions of main.c that divide by zero on frames without a frequency be timed
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "harness.h"
+
+#define Buffers			64
+#define Runs			15
+
+#pragma weak StatsOn
+
+const char *ModeNames[] = {"normal", "average", "exp avg", "peak", "hi-res", "envelope"};
+const uint8_t Scales[] = {8, 23};
+const uint8_t Zooms[] = {0, 3, 6};
+const uint8_t RenderModes[] = {0, 3};
+uint32_t Buffer[Buffers][MEM_BUFFER_SIZE];
+
+void UpdateMeasurements(void){
+}
+
+double Now(void){
+	struct timespec t;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// time the decode pass in every acquire mode at both time scales
+void TimeDecode(const char *Title){
+	uint32_t b, k, r, n;
+	double Start, Elapsed, Best;
+
+	printf("PixelsCalculation, ns per value%s\n", Title);
+	for(k=0;k<6;k++){
+		printf("  %-9s", ModeNames[k]);
+		for(r=0;r<sizeof(Scales);r++){
+			CaptureMode = k;
+			TriggerSweep = 1;
+			SetupTimeDivision(Scales[r]);
+			TriggerPosition = 160;
+			ArmTrigger();
+			TriggerLevel = 2048;
+			Best = 1e9;
+			for(n=0;n<Runs;n++){
+				Start = Now();
+				for(b=0;b<4000;b++)
+					PixelsCalculation(Buffer[b % Buffers]);
+				Elapsed = Now() - Start;
+				if(Elapsed < Best)
+					Best = Elapsed;
+			}
+			printf("  time %2d %6.2f", Scales[r], Best / 4000 / MEM_BUFFER_SIZE * 1e9);
+		}
+		printf("\n");
+	}
+}
+
+int main(void){
+	uint16_t Value;
+	uint32_t b, f, k, r, n;
+	double x = 0, Start, Elapsed, Best;
+
+	setup();
+	for(b=0;b<Buffers;b++){
+		for(f=0;f<MEM_BUFFER_SIZE;f++){
+			Value = 2048 + 1500 * sin(2 * M_PI * x / 57.3) + (rand() % 7);
+			Buffer[b][f] = EncodePair(Value, 4095 - Value);
+			x++;
+		}
+	}
+
+	TimeDecode("");
+	// older versions of main.c have no statistics overlay
+	if(&StatsOn != NULL){
+		StatsOn = 1;
+		TimeDecode(", statistics shown");
+		StatsOn = 0;
+	}
+
+	printf("RenderRecord, us per view\n");
+	for(k=0;k<sizeof(RenderModes);k++){
+		// freeze a full record with a single sweep
+		CaptureMode = RenderModes[k];
+		TriggerSweep = 2;
+		SingleArmed = 1;
+		SetupTimeDivision(8);
+		ArmTrigger();
+		TriggerLevel = 2048;
+		for(b=0;Frozen == 0 && b<1000;b++)
+			PixelsCalculation(Buffer[b % Buffers]);
+		printf("  %-9s", ModeNames[RenderModes[k]]);
+		for(r=0;r<sizeof(Zooms);r++){
+			ViewZoom = Zooms[r];
+			Best = 1e9;
+			for(n=0;n<Runs;n++){
+				Start = Now();
+				for(b=0;b<200;b++)
+					RenderRecord();
+				Elapsed = Now() - Start;
+				if(Elapsed < Best)
+					Best = Elapsed;
+			}
+			printf("  %2d slots %7.2f", 1 << Zooms[r], Best / 200 * 1e6);
+		}
+		printf("\n");
+		ResumeAcquisition();
+	}
+	return 0;
+}
@@ -0,0 +1,67 @@
+// Host test of the frequency counter with the cost of its interrupt. Timer 3 is modelled counting rising edges
+// of a steady input from 1 Hz to about 30 MHz and the handler is called at the edge that completes each count, the
+// Timer 1 reads in it being Handler clocks apart. No edges are counted from the completing edge until Timer 3
+// is started again, and the next count can only complete after that. The handler must take more edges by
+// itself fast enough to leave the CPU to the rest of the program, and every reading must be within a ppm
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include "harness.h"
+
+#define Clock			120000000.0
+#define Handler			300 // system clocks from the time stamp to Timer 3 counting again
+#define Entry			16 // system clocks from an edge to the time stamp
+
+const double Frequencies[] = {1, 1234.5, 1.5e6, 12.345e6, 29.97e6};
+
+int main(void){
+	double Period, Now, Busy, Load;
+	uint64_t Edge;
+	uint32_t Interrupts, Readings;
+	uint8_t k;
+	int Fails = 0;
+
+	setup();
+	ui32SysClkFreq = Clock;
+	TimerStubStep = 0;
+	for(k=0;k<sizeof(Frequencies)/sizeof(Frequencies[0]);k++){
+		Period = Clock / Frequencies[k];
+		TimerStubCount = 0;
+		CounterOn = 1;
+		CounterSetup();
+		Now = 0;
+		Busy = 0;
+		Interrupts = 0;
+		Readings = 0;
+		while(Readings < 4){
+			// the edge that completes the count, Timer 3 counts the first edge at or after it starts
+			Edge = ceil(Now / Period) + CounterEdges - 1;
+			TimerStubCount = (uint32_t)(uint64_t)(Edge * Period + Entry);
+			TimerStubStep = Handler;
+			Timer3IntHandler();
+			TimerStubStep = 0;
+			Now = Edge * Period + Entry + Handler;
+			Busy = Busy + Entry + Handler;
+			Interrupts++;
+			if(CounterReady == 1){
+				CounterUpdate();
+				Readings++;
+				if(fabs(CounterFrequency / Frequencies[k] - 1) > 1e-6){
+					printf("FAIL %g Hz: reading %d is %.7g Hz\n", Frequencies[k], Readings, CounterFrequency);
+					Fails++;
+				}
+			}
+		}
+		Load = Busy / Now;
+		if(Load > 0.01){
+			printf("FAIL %g Hz: %d interrupts in %.3f s keep the CPU %.1f%% busy\n", Frequencies[k], Interrupts,
+					Now / Clock, Load * 100);
+			Fails++;
+		}
+	}
+	CounterOn = 0;
+	CounterSetup();
+
+	printf("counter: %d failures\n", Fails);
+	return Fails != 0;
+}
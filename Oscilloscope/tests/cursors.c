@@ -0,0 +1,89 @@
+// Host test of the time cursors on a frozen record. A sine of known frequency is captured with a single sweep at
+// 1 s/div, where 24 of every 25 values are skipped, and the record is drawn at 1 to 8 ring slots per pixel. At
+// every zoom the time cursors are put a whole number of periods of the drawn sine apart, and 1/dt of the readout
+// times that number must give the frequency of the sine
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "harness.h"
+
+#define Period			57.3 // pixels per period of the sine at the captured time scale
+#define Amplitude		1500
+#define Scale			23 // 1 s/div
+
+// the value of a readout such as "104.7mHz"
+double ReadUnits(const char *Text){
+	const char *Prefixes = "num kMG";
+	char *End;
+	double Value = strtod(Text, &End);
+	const char *p = strchr(Prefixes, *End);
+
+	if(*End == 'H' || p == NULL)
+		return Value;
+	return Value * pow(1000, (p - Prefixes) - 3);
+}
+
+int main(void){
+	uint32_t Buffer[MEM_BUFFER_SIZE];
+	uint16_t f, Value, Low, High, n, Periods;
+	uint32_t b;
+	uint8_t z;
+	double x = 0, Samples, Frequency, Pixels, Rate;
+	int Fails = 0;
+
+	setup();
+	CaptureMode = 0;
+	TriggerSweep = 2;
+	SingleArmed = 1;
+	Time = Scale;
+	SetupTimeDivision(Time);
+	TriggerPosition = 160;
+	ArmTrigger();
+	TriggerLevel = 2048;
+	Samples = (NumSkip + 1) * Period;
+	Frequency = 1 / (Period * secpixel[Scale]);
+	for(b=0;Frozen == 0 && b<100000;b++){
+		for(f=0;f<MEM_BUFFER_SIZE;f++){
+			Value = 2048 + Amplitude * sin(2 * M_PI * x / Samples);
+			Buffer[f] = EncodePair(Value, 4095 - Value);
+			x++;
+		}
+		PixelsCalculation(Buffer);
+	}
+	if(Frozen == 0){
+		printf("FAIL the single sweep did not freeze a record\n");
+		return 1;
+	}
+
+	for(z=0;z<=3;z++){
+		if(z > 0)
+			ZoomRecord(1);
+		else
+			RenderRecord();
+		Low = 4095;
+		High = 0;
+		for(n=0;n<SERIES_LENGTH;n++){
+			if(pixels[n] < Low)
+				Low = pixels[n];
+			if(pixels[n] > High)
+				High = pixels[n];
+		}
+		Pixels = PixelPeriod(pixels, Low, High);
+		Periods = 300 / Pixels;
+		CursorColumn[0] = 10;
+		CursorColumn[1] = 10 + Periods * Pixels + 0.5;
+		DrawCursors();
+		Rate = ReadUnits(strstr(CursorDisplay, "1/dt ") + 5);
+		// the readout is in whole mHz at best
+		if(fabs(Rate - Frequency / Periods) > Frequency / Periods * 0.01 + 0.0005){
+			printf("FAIL zoom %d skip %d: %d periods of %.2f pixels read \"%s\", %g Hz for %g Hz\n", 1 << ViewZoom,
+					NumSkip, Periods, Pixels, CursorDisplay, Rate * Periods, Frequency);
+			Fails++;
+		}
+	}
+
+	printf("cursors: %d failures\n", Fails);
+	return Fails != 0;
+}
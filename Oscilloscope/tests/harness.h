@@ -0,0 +1,69 @@
+// What the host tests see of main.c, which is built with its main renamed to scope_main, and how they make up
+// the EPI words the ADC would send
+#ifndef HARNESS_H
+#define HARNESS_H
+#include <stdint.h>
+
+#define MEM_BUFFER_SIZE			1024
+#define SERIES_LENGTH			319
+#define MeasureKinds			13
+#define MEAS_RISE				3
+#define MEAS_FALL				4
+#define MEAS_PWIDTH				5
+#define MEAS_NWIDTH				6
+#define MEAS_JITTER				9
+
+extern uint8_t CaptureMode, TriggerSweep, TriggerSource, Time, ViewZoom, Frozen, SingleArmed;
+extern uint16_t NumSkip, TriggerPosition, TriggerLevel;
+extern uint16_t pixels[SERIES_LENGTH], pixels2[SERIES_LENGTH];
+extern float secpixel[];
+extern int16_t CursorColumn[2];
+extern char CursorDisplay[48];
+extern uint8_t CounterOn;
+extern uint32_t ui32SysClkFreq, CounterEdges;
+extern volatile uint8_t CounterReady;
+extern double CounterFrequency;
+extern uint32_t RecordSize, MeasureCycles[2];
+extern float MeasureJitter[2], MeasureCycleJitter[2], MeasureWidthSpread[2], MeasureAmplitudeSpread[2];
+extern uint8_t CycleRecord;
+extern float Measures[2][MeasureKinds];
+extern uint8_t HistogramOn;
+extern uint32_t HistogramCounts[256], SeriesCounts[256], SeriesSums[256];
+extern char HistogramDisplay[64];
+extern uint8_t Ch1on, Ch2on, MeasureSelect[2], StatsOn;
+extern uint32_t StatCount[2][MeasureKinds + 1];
+extern float StatMean[2][MeasureKinds + 1], StatM2[2][MeasureKinds + 1];
+extern float StatMin[2][MeasureKinds + 1], StatMax[2][MeasureKinds + 1], StatLast[2][MeasureKinds + 1];
+extern uint32_t TimerStubCount, TimerStubStep;
+extern char StubText[128];
+
+void setup(void);
+void SetupTimeDivision(uint8_t Scale);
+void ArmTrigger(void);
+void PixelsCalculation(uint32_t input[MEM_BUFFER_SIZE]);
+void RenderRecord(void);
+void ZoomRecord(int8_t Direction);
+void DrawCursors(void);
+void ResumeAcquisition(void);
+void CounterSetup(void);
+void CounterUpdate(void);
+void Timer3IntHandler(void);
+void DrawStats(void);
+void MeasureSeries(uint8_t c, uint16_t *series, uint16_t *low);
+void HistogramFrame(void);
+void FindLevels(const uint32_t *Counts, const uint32_t *Sums, uint16_t Low, uint16_t High, float *Level);
+float PixelPeriod(uint16_t *series, uint16_t Low, uint16_t High);
+uint32_t PairSubSatC(uint32_t a, uint32_t b);
+uint32_t PairMin(uint32_t a, uint32_t b);
+uint32_t PairMax(uint32_t a, uint32_t b);
+uint8_t PairAtLeast(uint32_t a, uint32_t b);
+
+// the EPI word of a pair of offset binary values. The ADC sends two's complement, channel 1 on bits 0-9 and 11-12
+// and channel 2 on bits 13-19 and 24-28
+static inline uint32_t EncodePair(uint16_t A, uint16_t B){
+	A = A ^ 0x800;
+	B = B ^ 0x800;
+	return (A & 0x3FF) | ((A & 0xC00) << 1) | ((B & 0x7F) << 13) | ((B & 0xF80) << 17);
+}
+
+#endif
@@ -0,0 +1,72 @@
+// Host test of the pair kernels. PairSubSatC must give what UQSUB16 gives, each half of a less that half of b
+// stopped at 0, for every pair of 12-bit values in each half, with the other half running through other values
+// at the same time so a borrow between the halves would show. PairMin, PairMax and PairAtLeast are checked
+// against plain compares the same way, the levels of PairAtLeast going up to 4096. Built for an M4 or another
+// core with the DSP instructions the instruction itself is checked as well
+#include <stdint.h>
+#include <stdio.h>
+#include "harness.h"
+#ifdef __ARM_FEATURE_SIMD32
+#include <arm_acle.h>
+#endif
+
+// what UQSUB16 does to each half
+uint32_t SubSat16(uint32_t a, uint32_t b){
+	uint32_t Low = ((a & 0xFFFF) > (b & 0xFFFF)) ? (a & 0xFFFF) - (b & 0xFFFF) : 0;
+	uint32_t High = ((a >> 16) > (b >> 16)) ? (a >> 16) - (b >> 16) : 0;
+
+	return Low | (High << 16);
+}
+
+uint32_t Min16(uint32_t a, uint32_t b){
+	return (((a & 0xFFFF) < (b & 0xFFFF)) ? a & 0xFFFF : b & 0xFFFF) |
+			(((a >> 16) < (b >> 16)) ? a >> 16 : b >> 16) << 16;
+}
+
+uint32_t Max16(uint32_t a, uint32_t b){
+	return (((a & 0xFFFF) > (b & 0xFFFF)) ? a & 0xFFFF : b & 0xFFFF) |
+			(((a >> 16) > (b >> 16)) ? a >> 16 : b >> 16) << 16;
+}
+
+int Fails = 0;
+
+void Check(uint32_t a, uint32_t b, uint32_t Level){
+	uint32_t Expected = SubSat16(a, b);
+	uint8_t AtLeast;
+
+	if(PairSubSatC(a, b) != Expected && Fails++ < 10)
+		printf("FAIL PairSubSatC(%08X, %08X) = %08X, not %08X\n", a, b, PairSubSatC(a, b), Expected);
+#ifdef __ARM_FEATURE_SIMD32
+	if(__uqsub16(a, b) != Expected && Fails++ < 10)
+		printf("FAIL __uqsub16(%08X, %08X) = %08X, not %08X\n", a, b, (uint32_t)__uqsub16(a, b), Expected);
+#endif
+	if(PairMin(a, b) != Min16(a, b) && Fails++ < 10)
+		printf("FAIL PairMin(%08X, %08X) = %08X, not %08X\n", a, b, PairMin(a, b), Min16(a, b));
+	if(PairMax(a, b) != Max16(a, b) && Fails++ < 10)
+		printf("FAIL PairMax(%08X, %08X) = %08X, not %08X\n", a, b, PairMax(a, b), Max16(a, b));
+	AtLeast = ((a & 0xFFFF) >= (Level & 0xFFFF)) | (((a >> 16) >= (Level >> 16)) << 1);
+	if(PairAtLeast(a, Level) != AtLeast && Fails++ < 10)
+		printf("FAIL PairAtLeast(%08X, %08X) = %d, not %d\n", a, Level, PairAtLeast(a, Level), AtLeast);
+}
+
+int main(void){
+	uint32_t x, y, u, v;
+
+	for(x=0;x<=4095;x++){
+		for(y=0;y<=4096;y++){
+			// the other half walks through 0 to 4095 at another pace, reaching both ends against every x
+			u = (x * 7 + y * 13) % 4096;
+			v = (x * 11 + y * 5 + 2048) % 4096;
+			if(y == 4096){
+				Check(x | (u << 16), 4095 | (v << 16), 4096 | (v << 16));
+				Check(u | (x << 16), v | (4095 << 16), v | (4096 << 16));
+				continue;
+			}
+			Check(x | (u << 16), y | (v << 16), y | (v << 16));
+			Check(u | (x << 16), v | (y << 16), v | (y << 16));
+		}
+	}
+
+	printf("pairs: %d failures\n", Fails);
+	return Fails != 0;
+}
@@ -0,0 +1,77 @@
+// Host test of the cycles of a frozen record. A sine on channel 1 whose cycles are alternately Short and Long
+// values long, and its mirror on channel 2, are captured with a single sweep at a time scale that keeps one of
+// every three values. Once the record is frozen every cycle in it must be counted, and the jitter, cycle to cycle
+// jitter and spread of the widths must follow from the two lengths. The amplitude of every cycle is the same
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include "harness.h"
+
+#define Short			60 // values in the even and odd cycles
+#define Long			80
+#define Amplitude		1500
+#define Scale			20 // 100 ms/div, NumSkip 2
+
+int Fails = 0;
+
+void Expect(const char *Name, uint8_t c, double Value, double Expected, double Tolerance){
+	if(fabs(Value - Expected) > Tolerance){
+		printf("FAIL channel %d %s: %g, not %g\n", c + 1, Name, Value, Expected);
+		Fails++;
+	}
+}
+
+int main(void){
+	uint32_t Buffer[MEM_BUFFER_SIZE];
+	uint32_t b, f, Cycle = 0, Start = 0, x = 0;
+	uint16_t Value;
+	uint8_t c;
+	double Second, Cycles;
+
+	setup();
+	// the cycles are only followed while a measurement that needs them is shown
+	MeasureSelect[0] = MEAS_JITTER;
+	CaptureMode = 0;
+	TriggerSweep = 2;
+	SingleArmed = 1;
+	Time = Scale;
+	SetupTimeDivision(Time);
+	TriggerPosition = 160;
+	ArmTrigger();
+	TriggerLevel = 2048;
+	for(b=0;Frozen == 0 && b<1000;b++){
+		for(f=0;f<MEM_BUFFER_SIZE;f++){
+			// cycle Cycle starts at value Start
+			if(x - Start == ((Cycle & 1) ? Long : Short)){
+				Start = x;
+				Cycle++;
+			}
+			Value = 2048 + Amplitude * sin(2 * M_PI * (x - Start) / ((Cycle & 1) ? Long : Short));
+			Buffer[f] = EncodePair(Value, 4095 - Value);
+			x++;
+		}
+		PixelsCalculation(Buffer);
+	}
+	if(Frozen == 0 || CycleRecord == 0){
+		printf("FAIL the single sweep did not freeze a record with its cycles\n");
+		return 1;
+	}
+
+	// seconds of a value, and the cycles that fit in the record between its first and last rising edge
+	Second = secpixel[Time] / (NumSkip + 1);
+	Cycles = (double)RecordSize * (NumSkip + 1) / ((Short + Long) / 2.0);
+	// channel 2 rises half way through every cycle of channel 1, so its periods are all the mean of the two. The
+	// crossings of channel 1 are interpolated between slots on either side of a change in slope, which moves them
+	// by a fraction of a value, and the widths are counted in whole slots
+	for(c=0;c<2;c++){
+		Expect("cycles", c, MeasureCycles[c], Cycles, 2);
+		Expect("jitter", c, MeasureJitter[c], (c == 0) ? (Long - Short) / 2.0 * Second : 0, (Long - Short) * Second * 0.05);
+		Expect("cycle to cycle jitter", c, MeasureCycleJitter[c], (c == 0) ? (Long - Short) * Second : 0,
+				(Long - Short) * Second * 0.05);
+		Expect("width spread", c, MeasureWidthSpread[c], (Long - Short) / 4.0 * Second, (NumSkip + 1) * Second);
+		Expect("amplitude spread", c, MeasureAmplitudeSpread[c], 0, 0.01);
+	}
+
+	printf("record: %d failures\n", Fails);
+	return Fails != 0;
+}
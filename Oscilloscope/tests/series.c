@@ -0,0 +1,78 @@
+// Host test of the measurements of a displayed frame. A trapezoid of known rise, fall and widths is measured the
+// first time MeasureSeries runs after setup, when no earlier frame has given a top and base, and must give its
+// times in full on that first frame. The same values in the histogram must give the same top and base to within
+// the middle of their bin, and noise below what the bins can show
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "harness.h"
+
+#define Base			1000
+#define Top				3000
+#define Flat			30 // pixels at the base and at the top
+#define Edge			10 // pixels of each rise and fall
+#define Scale			8
+
+int Fails = 0;
+
+void Expect(const char *Name, uint8_t Kind, double Pixels){
+	double Expected = Pixels * secpixel[Scale];
+
+	if(fabs(Measures[0][Kind] - Expected) > Expected * 0.02){
+		printf("FAIL %s: %g s, not %g s\n", Name, Measures[0][Kind], Expected);
+		Fails++;
+	}
+}
+
+int main(void){
+	uint16_t Series[SERIES_LENGTH];
+	uint16_t n, x;
+	float Level[2];
+
+	setup();
+	Time = Scale;
+	SetupTimeDivision(Time);
+	for(n=0;n<SERIES_LENGTH;n++){
+		x = n % (2 * (Flat + Edge));
+		if(x < Flat)
+			Series[n] = Base;
+		else if(x < Flat + Edge)
+			Series[n] = Base + (Top - Base) * (x - Flat) / Edge;
+		else if(x < 2 * Flat + Edge)
+			Series[n] = Top;
+		else
+			Series[n] = Top - (Top - Base) * (x - 2 * Flat - Edge) / Edge;
+	}
+	MeasureSeries(0, Series, Series);
+
+	// from 10% to 90% is 80% of an edge, the widths are at 50%, halfway through the edges on either side
+	Expect("rise time", MEAS_RISE, Edge * 0.8);
+	Expect("fall time", MEAS_FALL, Edge * 0.8);
+	Expect("positive width", MEAS_PWIDTH, Flat + Edge);
+	Expect("negative width", MEAS_NWIDTH, Flat + Edge);
+
+	// the pixels are binned with their sums, which give the levels exactly
+	FindLevels(SeriesCounts, SeriesSums, Base, Top, Level);
+	if(Level[0] != Base || Level[1] != Top){
+		printf("FAIL levels of the pixels %g and %g, not %d and %d\n", Level[0], Level[1], Base, Top);
+		Fails++;
+	}
+	// the histogram of the values only has counts, the middle of a bin standing for its values
+	for(n=0;n<SERIES_LENGTH;n++)
+		HistogramCounts[Series[n] >> 4]++;
+	FindLevels(HistogramCounts, 0, Base, Top, Level);
+	if(fabs(Level[0] - Base) > 8 || fabs(Level[1] - Top) > 8){
+		printf("FAIL levels of the histogram %g and %g, not %d and %d\n", Level[0], Level[1], Base, Top);
+		Fails++;
+	}
+	HistogramOn = 1;
+	HistogramFrame();
+	if(strstr(HistogramDisplay, "noise <") == NULL){
+		printf("FAIL the noise of levels within one bin reads \"%s\"\n", HistogramDisplay);
+		Fails++;
+	}
+
+	printf("series: %d failures\n", Fails);
+	return Fails != 0;
+}
@@ -0,0 +1,44 @@
+// Host test of the statistics overlay. Every measurement of both channels is given the longest values it can
+// show, negative with three significant digits and the smallest prefix, or the most places for % and deg, and
+// the most frames a count can hold. DrawStats must write each value and line within its buffers, which the
+// address sanitizer checks, and a whole line must fit in its buffer up to the padding at its end
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "harness.h"
+
+// the longest values of the units with prefixes and of % and deg, and their standard deviations
+const float Values[2] = {-12.34e-6, -0.009994};
+const float Deviations[2] = {12.34e-6, 0.009994};
+
+int main(void){
+	uint8_t c, k, u;
+	int Fails = 0;
+
+	setup();
+	Ch1on = 1;
+	Ch2on = 1;
+	for(c=0;c<2;c++){
+		for(k=0;k<=MeasureKinds;k++){
+			u = (k == 7 || k == 8 || k == 11);
+			StatCount[c][k] = 0xFFFFFFFF;
+			StatLast[c][k] = Values[u];
+			StatMean[c][k] = Values[u];
+			StatM2[c][k] = Deviations[u] * Deviations[u] * 4294967294.0;
+			StatMin[c][k] = Values[u];
+			StatMax[c][k] = Values[u];
+		}
+	}
+	for(k=0;k<MeasureKinds;k++){
+		MeasureSelect[0] = k;
+		MeasureSelect[1] = k;
+		DrawStats();
+		if(strlen(StubText) < 3 || strcmp(StubText + strlen(StubText) - 3, "   ") != 0){
+			printf("FAIL the line of measurement %d is cut short: \"%s\"\n", k, StubText);
+			Fails++;
+		}
+	}
+
+	printf("stats: %d failures\n", Fails);
+	return Fails != 0;
+}
@@ -0,0 +1 @@
+#include "../tiva_stub.h"
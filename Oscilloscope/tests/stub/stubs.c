@@ -0,0 +1,94 @@
+// Empty TivaWare functions for the host tests. Timer 1 reads count up by TimerStubStep each read so tests can
+// give the segment time stamps a clock, usprintf and usnprintf are the C library's vsprintf and vsnprintf, and
+// GrStringDraw keeps the last string drawn in StubText
+#include <stdarg.h>
+#include <stdio.h>
+#include "tiva_stub.h"
+const tFont *g_psFontCm12, *g_psFontCm14, *g_psFontCm16, *g_psFontCmss12, *g_psFontCmss14, *g_psFontCm20, *g_psFontFixed6x8;
+const tFont g_sFontCm20; const tDisplay g_sKentec320x240x16_SSD2119;
+const uint8_t g_pui8Image[1], g_pui9Image[1];
+void CanvasTextSet(tCanvasWidget * a0, const char * a1){}
+void PushButtonTextSet(tPushButtonWidget * a0, const char * a1){}
+void WidgetAdd(tWidget * a0, tWidget * a1){}
+void WidgetRemove(tWidget * a0){}
+void WidgetPaint(tWidget * a0){}
+void WidgetMessageQueueProcess(void){}
+int32_t WidgetPointerMessage(uint32_t a0, int32_t a1, int32_t a2){return 0;}
+void SliderValueSet(tSliderWidget * a0, int32_t a1){}
+void RadioButtonSelectedSet(tRadioButtonWidget * a0, bool a1){}
+void GrContextInit(tContext * a0, const tDisplay * a1){}
+void GrContextForegroundSet(tContext * a0, uint32_t a1){}
+void GrContextFontSet(tContext * a0, const tFont * a1){}
+void GrLineDraw(const tContext * a0, int32_t a1, int32_t a2, int32_t a3, int32_t a4){}
+void GrLineDrawV(const tContext * a0, int32_t a1, int32_t a2, int32_t a3){}
+void GrLineDrawH(const tContext * a0, int32_t a1, int32_t a2, int32_t a3){}
+void GrPixelDraw(const tContext * a0, int32_t a1, int32_t a2){}
+void GrRectFill(const tContext * a0, const tRectangle * a1){}
+void GrRectDraw(const tContext * a0, const tRectangle * a1){}
+void GrCircleFill(const tContext * a0, int32_t a1, int32_t a2, int32_t a3){}
+void GrFlush(const tContext * a0){}
+void GrImageDraw(const tContext * a0, const uint8_t * a1, int32_t a2, int32_t a3){}
+char StubText[128];
+void GrStringDraw(const tContext * a0, const char * a1, int32_t a2, int32_t a3, int32_t a4, bool a5){snprintf(StubText, sizeof(StubText), "%s", a1);}
+void Kentec320x240x16_SSD2119Init(uint32_t a0){}
+void TouchScreenInit(uint32_t a0){}
+void TouchScreenCallbackSet(int32_t (*a0)(uint32_t, int32_t, int32_t)){}
+void SysCtlDelay(uint32_t a0){}
+uint32_t SysCtlClockFreqSet(uint32_t a0, uint32_t a1){return 0;}
+void SysCtlPeripheralEnable(uint32_t a0){}
+void SysCtlPeripheralSleepEnable(uint32_t a0){}
+void SysCtlPWMClockSet(uint32_t a0){}
+void IntEnable(uint32_t a0){}
+void IntDisable(uint32_t a0){}
+bool IntMasterEnable(void){return 0;}
+bool IntMasterDisable(void){return 0;}
+void FPUEnable(void){}
+void FPULazyStackingEnable(void){}
+void GPIOPinConfigure(uint32_t a0){}
+void GPIOPinTypeEPI(uint32_t a0, uint8_t a1){}
+void GPIOPinTypeGPIOInput(uint32_t a0, uint8_t a1){}
+void GPIOPinTypeGPIOOutput(uint32_t a0, uint8_t a1){}
+void GPIOPinTypePWM(uint32_t a0, uint8_t a1){}
+void GPIOPinWrite(uint32_t a0, uint8_t a1, uint8_t a2){}
+void GPIOPinTypeTimer(uint32_t a0, uint8_t a1){}
+void EPIAddressMapSet(uint32_t a0, uint32_t a1){}
+void EPIConfigGPModeSet(uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3){}
+void EPIDividerSet(uint32_t a0, uint32_t a1){}
+void EPIFIFOConfig(uint32_t a0, uint32_t a1){}
+void EPIIntEnable(uint32_t a0, uint32_t a1){}
+void EPIIntDisable(uint32_t a0, uint32_t a1){}
+void EPIIntErrorClear(uint32_t a0, uint32_t a1){}
+uint32_t EPIIntStatus(uint32_t a0, bool a1){return 0;}
+void EPIModeSet(uint32_t a0, uint32_t a1){}
+void EPINonBlockingReadConfigure(uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3){}
+void EPINonBlockingReadStart(uint32_t a0, uint32_t a1, uint32_t a2){}
+void EPINonBlockingReadStop(uint32_t a0, uint32_t a1){}
+void PWMGenConfigure(uint32_t a0, uint32_t a1, uint32_t a2){}
+void PWMGenEnable(uint32_t a0, uint32_t a1){}
+void PWMGenPeriodSet(uint32_t a0, uint32_t a1, uint32_t a2){}
+void PWMOutputState(uint32_t a0, uint32_t a1, bool a2){}
+void PWMPulseWidthSet(uint32_t a0, uint32_t a1, uint32_t a2){}
+void uDMAChannelAssign(uint32_t a0){}
+void uDMAChannelAttributeDisable(uint32_t a0, uint32_t a1){}
+void uDMAChannelAttributeEnable(uint32_t a0, uint32_t a1){}
+void uDMAChannelControlSet(uint32_t a0, uint32_t a1){}
+void uDMAChannelEnable(uint32_t a0){}
+void uDMAChannelDisable(uint32_t a0){}
+void uDMAChannelTransferSet(uint32_t a0, uint32_t a1, void * a2, void * a3, uint32_t a4){}
+void uDMAControlBaseSet(void * a0){}
+void uDMAEnable(void){}
+void uDMAIntClear(uint32_t a0){}
+void TimerConfigure(uint32_t a0, uint32_t a1){}
+void TimerLoadSet(uint32_t a0, uint32_t a1, uint32_t a2){}
+void TimerEnable(uint32_t a0, uint32_t a1){}
+void TimerDisable(uint32_t a0, uint32_t a1){}
+void TimerIntEnable(uint32_t a0, uint32_t a1){}
+void TimerIntClear(uint32_t a0, uint32_t a1){}
+uint32_t TimerIntStatus(uint32_t a0, bool a1){return 0;}
+uint32_t TimerStubCount=0, TimerStubStep=0; uint32_t TimerValueGet(uint32_t a0, uint32_t a1){uint32_t v=TimerStubCount; TimerStubCount+=TimerStubStep; return v;}
+void TimerControlEvent(uint32_t a0, uint32_t a1, uint32_t a2){}
+void TimerPrescaleSet(uint32_t a0, uint32_t a1, uint32_t a2){}
+int usnprintf(char * a0, unsigned long a1, const char * a2, ...){va_list v; va_start(v,a2); int r=vsnprintf(a0,a1,a2,v); va_end(v); return r;}
+int usprintf(char * a0, const char * a1, ...){va_list v; va_start(v,a1); int r=vsprintf(a0,a1,v); va_end(v); return r;}
+void GrContextBackgroundSet(tContext * a0, uint32_t a1){}
+void TimerMatchSet(uint32_t a, uint32_t b, uint32_t c){} void TimerPrescaleMatchSet(uint32_t a, uint32_t b, uint32_t c){} void IntPrioritySet(uint32_t a, uint8_t b){}
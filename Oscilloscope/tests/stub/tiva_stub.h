@@ -0,0 +1,185 @@
+// Declarations of the TivaWare driverlib, grlib and utils functions and constants main.c uses, so it can be
+// built on the host for the tests. Every TivaWare header main.c includes is a file in this directory that
+// includes this one. The widget macros only keep what the tests need, the callbacks and texts
+#ifndef TIVA_STUB_H
+#define TIVA_STUB_H
+#include <stdint.h>
+#include <stdbool.h>
+typedef struct { int16_t i16XMin, i16YMin, i16XMax, i16YMax; } tRectangle;
+typedef struct { int dummy; } tDisplay;
+typedef struct { int dummy; } tFont;
+typedef struct { int dummy; } tContext;
+typedef struct tWidget { struct tWidget *psParent; } tWidget;
+typedef struct { tWidget sBase; void (*pfnOnPaint)(tWidget *, tContext *); const char *pcText; } tCanvasWidget;
+typedef struct { tWidget sBase; void (*pfnOnClick)(tWidget *); const char *pcText; } tPushButtonWidget;
+typedef struct { tWidget sBase; void (*pfnOnChange)(tWidget *, uint32_t); const char *pcText; } tRadioButtonWidget;
+typedef struct { tWidget sBase; void (*pfnOnChange)(tWidget *, int32_t); int32_t i32Value; } tSliderWidget;
+typedef struct { tWidget sBase; const char *pcText; } tContainerWidget;
+#define WIDGET_ROOT ((tWidget *)0)
+#define W_CHECK(parent, next, child, disp) { (tWidget *)(parent) }
+#define Canvas(sName, psParent, psNext, psChild, psDisplay, i32X, i32Y, i32Width, i32Height, ui32Style, ui32FillColor, ui32OutlineColor, ui32TextColor, psFont, pcText, pui8Image, pfnOnPaint) \
+  tCanvasWidget sName = { W_CHECK(psParent, psNext, psChild, psDisplay), pfnOnPaint, pcText }
+#define RectangularButtonStruct(psParent, psNext, psChild, psDisplay, i32X, i32Y, i32Width, i32Height, ui32Style, ui32FillColor, ui32PressFillColor, ui32OutlineColor, ui32TextColor, psFont, pcText, pui8Image, pui8PressImage, ui16AutoRepeatDelay, ui16AutoRepeatRate, pfnOnClick) \
+  { W_CHECK(psParent, psNext, psChild, psDisplay), pfnOnClick, pcText }
+#define RectangularButton(sName, psParent, psNext, psChild, psDisplay, i32X, i32Y, i32Width, i32Height, ui32Style, ui32FillColor, ui32PressFillColor, ui32OutlineColor, ui32TextColor, psFont, pcText, pui8Image, pui8PressImage, ui16AutoRepeatDelay, ui16AutoRepeatRate, pfnOnClick) \
+  tPushButtonWidget sName = RectangularButtonStruct(psParent, psNext, psChild, psDisplay, i32X, i32Y, i32Width, i32Height, ui32Style, ui32FillColor, ui32PressFillColor, ui32OutlineColor, ui32TextColor, psFont, pcText, pui8Image, pui8PressImage, ui16AutoRepeatDelay, ui16AutoRepeatRate, pfnOnClick)
+#define RadioButtonStruct(psParent, psNext, psChild, psDisplay, i32X, i32Y, i32Width, i32Height, ui16Style, ui16CircleSize, ui32FillColor, ui32OutlineColor, ui32TextColor, psFont, pcText, pui8Image, pfnOnChange) \
+  { W_CHECK(psParent, psNext, psChild, psDisplay), pfnOnChange, pcText }
+#define Slider(sName, psParent, psNext, psChild, psDisplay, i32X, i32Y, i32Width, i32Height, i32Min, i32Max, i32Value, ui32Style, ui32FillColor, ui32BackgroundFillColor, ui32OutlineColor, ui32TextColor, ui32BackgroundTextColor, psFont, pcText, pui8Image, pui8BackgroundImage, pfnOnChange) \
+  tSliderWidget sName = { W_CHECK(psParent, psNext, psChild, psDisplay), pfnOnChange, i32Value }
+#define Container(sName, psParent, psNext, psChild, psDisplay, i32X, i32Y, i32Width, i32Height, ui32Style, ui32FillColor, ui32OutlineColor, ui32TextColor, psFont, pcText) \
+  tContainerWidget sName = { W_CHECK(psParent, psNext, psChild, psDisplay), pcText }
+enum { CANVAS_STYLE_APP_DRAWN=1, CANVAS_STYLE_FILL=2, CANVAS_STYLE_OUTLINE=4, CANVAS_STYLE_TEXT=8, CANVAS_STYLE_TEXT_VCENTER=16,
+ CTR_STYLE_FILL=1, CTR_STYLE_OUTLINE=2, PB_STYLE_FILL=1, PB_STYLE_OUTLINE=2, PB_STYLE_TEXT=4, PB_STYLE_TEXT_OPAQUE=8, RB_STYLE_TEXT=1,
+ SL_STYLE_BACKG_FILL=1, SL_STYLE_FILL=2, SL_STYLE_OUTLINE=4, SL_STYLE_VERTICAL=8 };
+#define ClrBlack 0x000000 
+#define ClrGray 0x808080
+#define ClrRed 0xFF0000
+#define ClrSilver 0xC0C0C0
+#define ClrWhite 0xFFFFFF
+#define ClrYellow 0xFFFF00
+#define ClrGreen 0x008000
+#define ClrCyan 0x00FFFF
+#define ClrMagenta 0xFF00FF
+#define ClrDarkRed 0x8B0000
+#define ClrOlive 0x808000
+#define ClrDimGray 0x696969
+#define ClrDarkGray 0xA9A9A9
+#define ClrOrange 0xFFA500
+#define ClrBlue 0x0000FF
+#define ClrLime 0x00FF00
+extern const tFont *g_psFontCm12, *g_psFontCm14, *g_psFontCm16, *g_psFontCmss12, *g_psFontCmss14, *g_psFontCm20, *g_psFontFixed6x8;
+extern const tFont g_sFontCm20;
+extern const tDisplay g_sKentec320x240x16_SSD2119;
+void CanvasTextSet(tCanvasWidget *, const char *);
+void PushButtonTextSet(tPushButtonWidget *, const char *);
+void WidgetAdd(tWidget *, tWidget *); void WidgetRemove(tWidget *); void WidgetPaint(tWidget *);
+void WidgetMessageQueueProcess(void); int32_t WidgetPointerMessage(uint32_t, int32_t, int32_t);
+void SliderValueSet(tSliderWidget *, int32_t);
+void RadioButtonSelectedSet(tRadioButtonWidget *, bool);
+void GrContextInit(tContext *, const tDisplay *); void GrContextForegroundSet(tContext *, uint32_t);
+void GrContextBackgroundSet(tContext *, uint32_t);
+void GrContextFontSet(tContext *, const tFont *);
+void GrLineDraw(const tContext *, int32_t, int32_t, int32_t, int32_t);
+void GrLineDrawV(const tContext *, int32_t, int32_t, int32_t);
+void GrLineDrawH(const tContext *, int32_t, int32_t, int32_t);
+void GrPixelDraw(const tContext *, int32_t, int32_t); void GrRectFill(const tContext *, const tRectangle *);
+void GrRectDraw(const tContext *, const tRectangle *);
+void GrCircleFill(const tContext *, int32_t, int32_t, int32_t); void GrFlush(const tContext *);
+void GrImageDraw(const tContext *, const uint8_t *, int32_t, int32_t);
+void GrStringDraw(const tContext *, const char *, int32_t, int32_t, int32_t, bool);
+#define IMAGE_FMT_4BPP_COMP 0x84
+#define IMAGE_FMT_8BPP_COMP 0x88
+void Kentec320x240x16_SSD2119Init(uint32_t); void TouchScreenInit(uint32_t);
+void TouchScreenCallbackSet(int32_t (*)(uint32_t, int32_t, int32_t));
+/* driverlib */
+void SysCtlDelay(uint32_t); uint32_t SysCtlClockFreqSet(uint32_t, uint32_t);
+void SysCtlPeripheralEnable(uint32_t); void SysCtlPeripheralSleepEnable(uint32_t); void SysCtlPWMClockSet(uint32_t);
+void IntEnable(uint32_t); void IntDisable(uint32_t); bool IntMasterEnable(void); bool IntMasterDisable(void);
+void FPUEnable(void); void FPULazyStackingEnable(void);
+void GPIOPinConfigure(uint32_t); void GPIOPinTypeEPI(uint32_t, uint8_t); void GPIOPinTypeGPIOInput(uint32_t, uint8_t);
+void GPIOPinTypeGPIOOutput(uint32_t, uint8_t); void GPIOPinTypePWM(uint32_t, uint8_t); void GPIOPinWrite(uint32_t, uint8_t, uint8_t);
+void GPIOPinTypeTimer(uint32_t, uint8_t);
+void EPIAddressMapSet(uint32_t, uint32_t); void EPIConfigGPModeSet(uint32_t, uint32_t, uint32_t, uint32_t);
+void EPIDividerSet(uint32_t, uint32_t); void EPIFIFOConfig(uint32_t, uint32_t); void EPIIntEnable(uint32_t, uint32_t);
+void EPIIntDisable(uint32_t, uint32_t);
+void EPIIntErrorClear(uint32_t, uint32_t); uint32_t EPIIntStatus(uint32_t, bool); void EPIModeSet(uint32_t, uint32_t);
+void EPINonBlockingReadConfigure(uint32_t, uint32_t, uint32_t, uint32_t); void EPINonBlockingReadStart(uint32_t, uint32_t, uint32_t);
+void EPINonBlockingReadStop(uint32_t, uint32_t);
+void PWMGenConfigure(uint32_t, uint32_t, uint32_t); void PWMGenEnable(uint32_t, uint32_t); void PWMGenPeriodSet(uint32_t, uint32_t, uint32_t);
+void PWMOutputState(uint32_t, uint32_t, bool); void PWMPulseWidthSet(uint32_t, uint32_t, uint32_t);
+void uDMAChannelAssign(uint32_t); void uDMAChannelAttributeDisable(uint32_t, uint32_t); void uDMAChannelAttributeEnable(uint32_t, uint32_t);
+void uDMAChannelControlSet(uint32_t, uint32_t); void uDMAChannelEnable(uint32_t); void uDMAChannelDisable(uint32_t);
+void uDMAChannelTransferSet(uint32_t, uint32_t, void *, void *, uint32_t);
+void uDMAControlBaseSet(void *); void uDMAEnable(void); void uDMAIntClear(uint32_t);
+void TimerConfigure(uint32_t, uint32_t); void TimerLoadSet(uint32_t, uint32_t, uint32_t); void TimerEnable(uint32_t, uint32_t);
+void TimerDisable(uint32_t, uint32_t); void TimerIntEnable(uint32_t, uint32_t); void TimerIntClear(uint32_t, uint32_t);
+uint32_t TimerIntStatus(uint32_t, bool); uint32_t TimerValueGet(uint32_t, uint32_t); void TimerControlEvent(uint32_t, uint32_t, uint32_t);
+void TimerPrescaleSet(uint32_t, uint32_t, uint32_t);
+enum { TIMER_A=1, TIMER_B=2, TIMER_BOTH=3, TIMER_CFG_PERIODIC=0x22, TIMER_CFG_PERIODIC_UP=0x32, TIMER_CFG_SPLIT_PAIR=0x4000000, TIMER_CFG_A_CAP_TIME_UP=0x17,
+ TIMER_CFG_A_CAP_TIME=0x7, TIMER_TIMA_TIMEOUT=1, TIMER_CAPA_EVENT=4, TIMER_EVENT_POS_EDGE=0, TIMER_CFG_A_PERIODIC=0x22, TIMER_CFG_B_PERIODIC=0x2200, TIMER_TIMB_TIMEOUT=0x100 };
+#define TIMER0_BASE 0x40030000
+#define TIMER1_BASE 0x40031000
+#define TIMER2_BASE 0x40032000
+#define TIMER3_BASE 0x40033000
+#define INT_TIMER0A 35
+#define INT_TIMER1A 37
+#define INT_TIMER2A 39
+#define INT_TIMER3A 51
+#define GPIO_PD0_T0CCP0 0x1
+#define GPIO_PD2_T1CCP0 0x2
+#define GPIO_PD4_T3CCP0 0x3
+#define GPIO_PA2_T1CCP0 0x4
+#define GPIO_PL4_T0CCP0 0x5
+#define GPIO_PM0_T2CCP0 0x6
+#define SYSCTL_PERIPH_TIMER1 0xf0000401
+#define SYSCTL_PERIPH_TIMER2 0xf0000402
+#define SYSCTL_PERIPH_TIMER3 0xf0000403
+enum { GPIO_PIN_0=1, GPIO_PIN_1=2, GPIO_PIN_2=4, GPIO_PIN_3=8, GPIO_PIN_4=16, GPIO_PIN_5=32, GPIO_PIN_6=64, GPIO_PIN_7=128 };
+#define GPIO_PORTA_BASE 1
+#define GPIO_PORTB_BASE 2
+#define GPIO_PORTC_BASE 3
+#define GPIO_PORTD_BASE 4
+#define GPIO_PORTE_BASE 5
+#define GPIO_PORTF_BASE 6
+#define GPIO_PORTG_BASE 7
+#define GPIO_PORTK_BASE 8
+#define GPIO_PORTL_BASE 9
+#define GPIO_PORTM_BASE 10
+#define GPIO_PORTP_BASE 11
+#define GPIO_PA6_EPI0S8 1
+#define GPIO_PA7_EPI0S9 1
+#define GPIO_PB2_EPI0S27 1
+#define GPIO_PB3_EPI0S28 1
+#define GPIO_PC4_EPI0S7 1
+#define GPIO_PC5_EPI0S6 1
+#define GPIO_PC6_EPI0S5 1
+#define GPIO_PC7_EPI0S4 1
+#define GPIO_PF1_M0PWM1 1
+#define GPIO_PG0_EPI0S11 1
+#define GPIO_PK0_EPI0S0 1
+#define GPIO_PK1_EPI0S1 1
+#define GPIO_PK2_EPI0S2 1
+#define GPIO_PK3_EPI0S3 1
+#define GPIO_PK6_EPI0S25 1
+#define GPIO_PK7_EPI0S24 1
+#define GPIO_PL0_EPI0S16 1
+#define GPIO_PL1_EPI0S17 1
+#define GPIO_PL2_EPI0S18 1
+#define GPIO_PL3_EPI0S19 1
+#define GPIO_PL4_EPI0S26 1
+#define GPIO_PM0_EPI0S15 1
+#define GPIO_PM1_EPI0S14 1
+#define GPIO_PM2_EPI0S13 1
+#define GPIO_PM3_EPI0S12 1
+#define EPI0_BASE 0x400D0000
+#define EPI_O_READFIFO0 0x70
+enum { EPI_ADDR_PER_BASE_A=1, EPI_ADDR_PER_SIZE_256B=2, EPI_FIFO_CONFIG_RX_1_2=1, EPI_GPMODE_ASIZE_NONE=0, EPI_GPMODE_CLKPIN=1, EPI_GPMODE_DSIZE_32=3,
+ EPI_INT_DMA_RX_DONE=8, EPI_INT_ERR_DMARDIC=8, EPI_INT_RXREQ=2, EPI_MODE_GENERAL=0x10, EPI_NBCONFIG_SIZE_32=3 };
+enum { INT_EPI0=1, INT_UDMA=2, INT_UDMAERR=3 };
+enum { PWM_GEN_0=0x40, PWM_GEN_MODE_DOWN=0, PWM_GEN_MODE_NO_SYNC=0, PWM_OUT_1=0x41, PWM_OUT_1_BIT=2 };
+#define PWM0_BASE 0x40028000
+enum { SYSCTL_CFG_VCO_480=0xF1000000, SYSCTL_OSC_MAIN=0, SYSCTL_USE_PLL=0, SYSCTL_XTAL_25MHZ=0x680, SYSCTL_PWMDIV_1=0 };
+#define SYSCTL_PERIPH_EPI0 1
+#define SYSCTL_PERIPH_GPIOA 2
+#define SYSCTL_PERIPH_GPIOB 3
+#define SYSCTL_PERIPH_GPIOC 4
+#define SYSCTL_PERIPH_GPIOD 5
+#define SYSCTL_PERIPH_GPIOE 6
+#define SYSCTL_PERIPH_GPIOF 7
+#define SYSCTL_PERIPH_GPIOG 8
+#define SYSCTL_PERIPH_GPIOK 9
+#define SYSCTL_PERIPH_GPIOL 10
+#define SYSCTL_PERIPH_GPIOM 11
+#define SYSCTL_PERIPH_GPIOP 12
+#define SYSCTL_PERIPH_PWM0 13
+#define SYSCTL_PERIPH_TIMER0 14
+#define SYSCTL_PERIPH_UDMA 15
+enum { UDMA_ALT_SELECT=0x20, UDMA_ARB_8=0x3c000, UDMA_ATTR_ALTSELECT=2, UDMA_ATTR_HIGH_PRIORITY=4, UDMA_ATTR_REQMASK=8, UDMA_ATTR_USEBURST=1,
+ UDMA_CH30_EPI0RX=30, UDMA_CHANNEL_SW=30, UDMA_DST_INC_32=0x2, UDMA_MODE_PINGPONG=3, UDMA_PRI_SELECT=0, UDMA_SIZE_32=0x2, UDMA_SRC_INC_NONE=0xc };
+int usnprintf(char *, unsigned long, const char *, ...);
+int usprintf(char *, const char *, ...);
+#define TIMER_CAPA_MATCH 0x2
+#define TIMER_CFG_A_CAP_COUNT 0x3
+void TimerMatchSet(uint32_t, uint32_t, uint32_t); void TimerPrescaleMatchSet(uint32_t, uint32_t, uint32_t); void IntPrioritySet(uint32_t, uint8_t);
+#endif
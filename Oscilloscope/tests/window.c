@@ -0,0 +1,99 @@
+// Host test of the pre/post-trigger window over the ring. A sine wave on channel 1 and its mirror on channel 2
+// are fed through PixelsCalculation at every time scale, at trigger positions from the left edge to the right
+// edge, in normal and averaging modes. Each frame must cross the trigger level at the trigger position, keep
+// the two channels mirrored and show the sine with one pixel for every NumSkip+1 values. Every time scale must
+// also give the seconds per pixel of its label, a division being 30 pixels
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "harness.h"
+
+#define Period			57.3 // pixels per period of the sine
+#define Amplitude		1500
+
+const uint16_t Positions[] = {0, 1, 80, 160, 318, 319};
+// seconds per division of each time scale
+const double Divisions[29] = {20e-9, 50e-9, 100e-9, 200e-9, 500e-9, 1e-6, 2e-6, 5e-6, 10e-6, 20e-6, 50e-6, 100e-6,
+		200e-6, 500e-6, 1e-3, 2e-3, 5e-3, 10e-3, 20e-3, 50e-3, 100e-3, 200e-3, 500e-3, 1, 2, 5, 10, 20, 50};
+
+int main(void){
+	uint32_t Buffer[MEM_BUFFER_SIZE];
+	uint16_t Time, n, f, Value, Low, High;
+	uint8_t Mode, k;
+	uint32_t Buffers, b;
+	int16_t Trigger;
+	double x, Samples, Slope, Pixels;
+	int Fails = 0;
+
+	setup();
+	TriggerSweep = 1;
+	for(Mode=0;Mode<2;Mode++){
+		CaptureMode = Mode;
+		for(Time=0;Time<=28;Time++){
+			SetupTimeDivision(Time);
+			if(fabs(secpixel[Time] * 30 / Divisions[Time] - 1) > 1e-3){
+				printf("FAIL time %d: %g s per pixel for %g s per division\n", Time, secpixel[Time], Divisions[Time]);
+				Fails++;
+			}
+			Samples = (NumSkip + 1) * Period;
+			// the values between two pixels straddling the trigger level can be up to one pixel of the slope apart
+			Slope = Amplitude * 2 * M_PI / Period;
+			for(k=0;k<sizeof(Positions)/sizeof(Positions[0]);k++){
+				TriggerPosition = Positions[k];
+				ArmTrigger();
+				TriggerLevel = 2048;
+				for(n=0;n<SERIES_LENGTH;n++)
+					pixels[n] = 0;
+
+				// enough buffers for a few frames, averaging needs NumAvg of them
+				Buffers = (NumSkip + 1) * 320 * ((Mode == 1) ? 30 : 3) / MEM_BUFFER_SIZE + 20;
+				x = 0.3 * k;
+				for(b=0;b<Buffers;b++){
+					for(f=0;f<MEM_BUFFER_SIZE;f++){
+						Value = 2048 + Amplitude * sin(2 * M_PI * x / Samples);
+						Buffer[f] = EncodePair(Value, 4095 - Value);
+						x++;
+					}
+					PixelsCalculation(Buffer);
+				}
+
+				// the trigger pixel is at the level and the one before it below, on a rising edge
+				Trigger = (TriggerPosition > SERIES_LENGTH - 1) ? SERIES_LENGTH - 1 : TriggerPosition;
+				if(abs(pixels[Trigger] - 2048) > Slope * 1.2 + 3 ||
+						(Trigger > 0 && TriggerPosition <= SERIES_LENGTH - 1 && pixels[Trigger - 1] > 2048 + 5)){
+					printf("FAIL mode %d time %d skip %d position %d: pixel %d before %d\n", Mode, Time, NumSkip,
+							TriggerPosition, pixels[Trigger], (Trigger > 0) ? pixels[Trigger - 1] : -1);
+					Fails++;
+				}
+				for(n=0;n<SERIES_LENGTH;n++){
+					if(abs(pixels[n] + pixels2[n] - 4095) > 40){
+						printf("FAIL mode %d time %d position %d: channels apart at %d: %d %d\n", Mode, Time,
+								TriggerPosition, n, pixels[n], pixels2[n]);
+						Fails++;
+						break;
+					}
+				}
+
+				// NumSkip of the time scale sets how many values make up a pixel
+				Low = 4095;
+				High = 0;
+				for(n=0;n<SERIES_LENGTH;n++){
+					if(pixels[n] < Low)
+						Low = pixels[n];
+					if(pixels[n] > High)
+						High = pixels[n];
+				}
+				Pixels = PixelPeriod(pixels, Low, High);
+				if(fabs(Pixels / Period - 1) > 0.01){
+					printf("FAIL mode %d time %d skip %d position %d: period %.2f pixels, not %.2f\n", Mode, Time,
+							NumSkip, TriggerPosition, Pixels, Period);
+					Fails++;
+				}
+			}
+		}
+	}
+
+	printf("window: %d failures\n", Fails);
+	return Fails != 0;
+}